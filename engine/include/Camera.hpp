@@ -6,15 +6,22 @@
 #pragma once
 
 #include "type/Vector2.hpp"
+#include "type/RowColumnIndex.hpp"
+#include "RenderQueue.hpp"
 
 #include <SFML/Graphics/RenderWindow.hpp>
 
+#include <memory>
+#include <vector>
+
 namespace nemo
 {
 
 // Forward declarations.
 class World;
 class Entity;
+class EntityRegistry;
+class TilemapRenderer;
 
 /**
  * \brief
@@ -33,6 +40,12 @@ public:
 	 */
 	Camera(const type::Vector2 size);
 
+	/**
+	 * \brief
+	 * Destructor.
+	 */
+	~Camera();
+
 	/**
 	 * \brief
 	 * Move the center of the camera view.
@@ -58,13 +71,52 @@ public:
 	 * \param window      Game's render window.
 	 * \param world       Area map.
 	 * \param entities    All the entities on the area map.
+	 * \param alpha       How far the game is between the last simulation tick
+	 *                    and the next one, from 0 to 1.
+	 * 
+	 * Only the tiles and entities within the camera view, plus a small margin 
+	 * around it, are drawn, so the cost of a frame depends on the size of the 
+	 * view rather than the size of the area map. Tiles are culled by whole 
+	 * chunks; entities are culled individually, then drawn together on top of
+	 * the tiles.
 	 */
 	void
 	drawView(
-		sf::RenderWindow&            window, 
-		const World&                 world,
-		const std::vector< Entity >& entities
-	) const;
+		sf::RenderWindow& window, 
+		const World&      world,
+		EntityRegistry&   entities,
+		const float       alpha = 1.f
+	);
+
+	/**
+	 * \brief
+	 * Gets the tiles within the camera view, plus a margin around it.
+	 * 
+	 * \param world
+	 * Area map.
+	 * 
+	 * \return
+	 * (1) First row and column of the visible tiles, and (2) number of rows and
+	 * columns of visible tiles. Both are clamped to \a world.
+	 */
+	std::pair< type::RowColumnIndex, type::RowColumnIndex >
+	visibleTiles(const World& world)
+	const noexcept;
+
+	/**
+	 * \brief
+	 * Checks whether an entity is within the camera view, plus a margin around
+	 * it.
+	 * 
+	 * \param entity
+	 * Entity in the game.
+	 * 
+	 * \return
+	 * True if the entity is to be drawn, false otherwise.
+	 */
+	bool
+	isVisible(const Entity& entity)
+	const noexcept;
 
 private:
 	/// Center coordinates of the camera.
@@ -72,6 +124,12 @@ private:
 
 	/// Window wize of the camera.
 	type::Vector2 _size;
+
+	/// Batched renderer of the area map last drawn.
+	std::unique_ptr< TilemapRenderer > _tilemap;
+
+	/// Render commands of the visible entities.
+	RenderQueue                        _entity_queue;
 };
 
 } 
\ No newline at end of file
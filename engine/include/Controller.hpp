@@ -5,14 +5,17 @@
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 
+#include "InputPump.hpp"
+
 #include <SFML/Window/Keyboard.hpp>
-#include <boost/bimap.hpp>
-#include <boost/bimap/unordered_set_of.hpp>
-#include <boost/bimap/list_of.hpp>
 
 #include <optional>
-#include <deque>
+#include <array>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
+#include <initializer_list>
 
 namespace nemo
 {
@@ -48,37 +51,36 @@ enum class Button
  * player to change what keyboard key translates to which controller input if, 
  * for example, the default mapping doesn't work out for any reason.
  * 
+ * Key states and mappings live in flat arrays indexed by key code and button,
+ * and the keys currently pressed are kept in a small ring, most recent first.
+ * Queries are therefore bounded by the ring's capacity and never allocate, so
+ * they're cheap enough to be made several times a frame.
+ * 
  * Usage example:
  * \code
  * 	sf::RenderWindow window(sf::VideoMode(1280, 720), "Nemo");
  * 	window.setKeyRepeatEnabled(false);
- *  
+ * 
+ * 	nemo::InputPump input;
  * 	nemo::Controller controller;
  * 	controller.changeKeyMapping(sf::Keyboard::O, Button::Cancel);
- * 	
+ * 
+ * 	// Masks are built once, not on every query.
+ * 	constexpr auto moves = nemo::Controller::mask({
+ * 		Button::Left, Button::Right
+ * 	});
+ * 
  * 	while (window.isOpen()) {
- *		sf::Event event;
+ * 		nemo::Controller::registerKeyEvents(input.drain(window));
  * 
- * 		if (!window.pollEvent(event)) {
- * 			continue;
- * 		}
- *     	
- * 		switch (event.type) {
- * 			case sf::Event::KeyPressed:
- * 			nemo::Controller::registerKeyPress(event.key.code);
- * 			break;
+ * 		const auto button = controller.pressedButton(moves);
  * 
- * 			case sf::Event::KeyReleased:
- * 			nemo::Controller::registerKeyRelease(event.key.code);
- * 			break;
- * 		}
- *    	
- * 		if (!controller->pressedButton()) {
+ * 		if (!button) {
  * 			continue;
  * 		}
  * 
- * 		switch (*controller->pressedButton()) {
- * 			case Button::left:
+ * 		switch (*button) {
+ * 			case Button::Left:
  * 			// move left
  * 			break;
  * 
@@ -86,7 +88,7 @@ enum class Button
  * 			// move right
  * 			break;
  * 		}
- *	}
+ * 	}
  * \endcode
  */
 class Controller
@@ -94,6 +96,45 @@ class Controller
 public:
 	using key_t = sf::Keyboard::Key;
 
+	/// Set of controller inputs, one bit per \link Button.
+	using button_mask_t = std::uint32_t;
+
+	/// Number of controller inputs. Button::Pause is the last one.
+	static constexpr auto _num_buttons = 
+		static_cast< std::size_t >(Button::Pause) + 1;
+
+	/// Set of all controller inputs.
+	static constexpr button_mask_t _any_button = (1u << _num_buttons) - 1;
+
+	/// Most keys that can be tracked as pressed at once.
+	static constexpr std::size_t _max_pressed_keys = 16;
+
+	/// Keys that are pressed at once, most recently pressed first.
+	using pressed_keys_t = std::array< key_t, _max_pressed_keys >;
+
+	/**
+	 * \brief
+	 * Gets the set of a number of controller inputs.
+	 * 
+	 * \param buttons
+	 * Controller inputs.
+	 * 
+	 * \return
+	 * Set of \a buttons.
+	 */
+	static constexpr button_mask_t
+	mask(const std::initializer_list< Button > buttons)
+	noexcept
+	{
+		button_mask_t m = 0;
+
+		for (const Button b : buttons) {
+			m |= 1u << static_cast< unsigned >(b);
+		}
+
+		return m;
+	}
+
 	/**
 	 * \brief
 	 * Constructs a controller that has default key mappings.
@@ -189,6 +230,47 @@ public:
 	static void
 	registerKeyRelease(const T key) = delete;
 
+	/**
+	 * \brief
+	 * Registers every key press and release among a batch of window events.
+	 * 
+	 * \param events
+	 * Events in the order they happened, usually everything \link 
+	 * InputPump::drain returned for the current frame. Events that aren't key 
+	 * presses or releases are ignored.
+	 * 
+	 * This is the same as calling \link registerKeyPress and \link 
+	 * registerKeyRelease for each event in order, so a key pressed and released
+	 * within the same frame doesn't leave a stale press behind.
+	 */
+	static void
+	registerKeyEvents(const std::vector< InputEvent >& events);
+
+	/**
+	 * \brief
+	 * Gets the keys currently pressed.
+	 * 
+	 * \param keys
+	 * Receives the pressed keys, most recently pressed first.
+	 * 
+	 * \return
+	 * Number of keys written to \a keys.
+	 */
+	static std::size_t
+	pressedKeys(pressed_keys_t& keys)
+	noexcept;
+
+	/**
+	 * \brief
+	 * Replaces the keys currently pressed, e.g. to replay recorded input.
+	 * 
+	 * \param keys     Pressed keys, most recently pressed first.
+	 * \param count    Number of pressed keys in \a keys.
+	 */
+	static void
+	setPressedKeys(const pressed_keys_t& keys, const std::size_t count)
+	noexcept;
+
 	/**
 	 * \brief
 	 * Gets a directional input based on keys currently pressed.
@@ -207,7 +289,7 @@ public:
 	 */
 	std::optional< Button >
 	pressedDirection()
-	const;
+	const noexcept;
 
 	/**
 	 * \brief
@@ -227,20 +309,19 @@ public:
 	 */
 	std::optional< Button >
 	pressedSelection()
-	const;
+	const noexcept;
 
 	/**
 	 * \brief 
 	 * Gets a controller input based on keys currently pressed.
 	 * 
 	 * \param button_filters
-	 * Controls to limit the returned result to.
+	 * Set of controls to limit the returned result to. See \link mask.
 	 * 
-	 * If \a button_filters is empty or not used, then this method will return 
-	 * any control that is mapped to the keys currently pressed. Otherwise, it 
-	 * will return one of the controls in the filter list. This is a more 
-	 * customized query than \link pressedDirection and \link 
-	 * pressedSelection.
+	 * If \a button_filters is not used, then this method will return any 
+	 * control that is mapped to the keys currently pressed. Otherwise, it will 
+	 * return one of the controls in the filter set. This is a more customized 
+	 * query than \link pressedDirection and \link pressedSelection.
 	 * 
 	 * If more than one of the keys mapped to the requested controls are 
 	 * currently pressed, then this method will return the control corresponding
@@ -251,8 +332,24 @@ public:
 	 * Controller input among \a button_filters, if any.
 	 */
 	std::optional< Button >
-	pressedButton(const std::vector< Button > button_filters = {})
-	const;
+	pressedButton(const button_mask_t button_filters = _any_button)
+	const noexcept;
+
+	/**
+	 * \brief 
+	 * Gets a controller input based on keys currently pressed.
+	 * 
+	 * \param button_filters
+	 * Controls to limit the returned result to.
+	 * 
+	 * Same as the overload taking a set of controls.
+	 * 
+	 * \return
+	 * Controller input among \a button_filters, if any.
+	 */
+	std::optional< Button >
+	pressedButton(const std::initializer_list< Button > button_filters)
+	const noexcept;
 	
 	/**
 	 * \brief
@@ -319,12 +416,10 @@ public:
 	const;
 
 private:
-	using keyboard_to_controller_t = boost::bimap< 
-		boost::bimaps::unordered_set_of< key_t >,
-		boost::bimaps::unordered_set_of< Button >,
-		boost::bimaps::list_of_relation
-	>;
-	
+	/// Number of keyboard keys.
+	static constexpr auto _num_keys = 
+		static_cast< std::size_t >(key_t::KeyCount);
+
 	/**
 	 * \brief
 	 * Change current keyboard mappings to the default.
@@ -342,13 +437,27 @@ private:
 	useDefaultKeyMappings();	
 
 	/// Path to controller's keyboard mapping file.
-	std::filesystem::path      _config_file;
+	std::filesystem::path                            _config_file;
+
+	/// Control that each key is mapped to, indexed by key code.
+	std::array< std::optional< Button >, _num_keys > _key_to_button;
+
+	/// Key that each control is mapped to, indexed by control.
+	std::array< key_t, _num_buttons >                _button_to_key;
+
+	/// Whether each keyboard key is currently pressed, indexed by key code.
+	static std::array< bool, _num_keys >             _is_key_pressed;
+
+	/// Ring of keyboard keys the player is currently pressing. The most 
+	/// recently pressed key is at \link _newest_key, and the rest follow it in 
+	/// the order they were pressed.
+	static pressed_keys_t                            _pressed_keys;
 
-	/// Bidrectional key-to-control mappings.
-	keyboard_to_controller_t   _key_mappings;
+	/// Position of the most recently pressed key in the ring.
+	static std::size_t                               _newest_key;
 
-	/// Keyboard keys the player is currently pressing.
-	static std::deque< key_t > _pressed_keys;
+	/// Number of keys in the ring.
+	static std::size_t                               _num_pressed_keys;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
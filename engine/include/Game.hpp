@@ -6,8 +6,15 @@
 #pragma once
 
 #include "entity/Entity.hpp"
+#include "entity/EntityRegistry.hpp"
+#include "InputRecording.hpp"
+#include "World/World.hpp"
+#include "Camera.hpp"
+#include "util/JobSystem.hpp"
 #include <SFML/Graphics/RenderWindow.hpp>
 
+#include <chrono>
+
 namespace nemo
 {
 
@@ -17,6 +24,16 @@ namespace nemo
 class Game
 {
 public:
+	/**
+	 * \brief Time spent in each phase of a frame.
+	 */
+	struct PhaseTimes
+	{
+		std::chrono::microseconds _ai;       /// AIs deciding on actions.
+		std::chrono::microseconds _movement; /// Entities moving.
+		std::chrono::microseconds _render;   /// Entities being drawn.
+	};
+
 	/**
 	 * \brief Creates and shares single game session.
 	 * 
@@ -39,13 +56,105 @@ public:
 	resume()
 	noexcept;
 
+	/**
+	 * \brief Changes how many times per second the game is simulated.
+	 * 
+	 * \param ticks_per_second Simulation rate. Defaults to 
+	 * constants::_tick_rate.
+	 */
+	void
+	setTickRate(const unsigned ticks_per_second)
+	noexcept;
+
+	/**
+	 * \brief Starts or stops recording the player's input on every tick.
+	 * 
+	 * \param recorder Recorder to write the input to, or nullptr to stop 
+	 * recording. The game doesn't own it.
+	 */
+	void
+	setRecorder(InputRecorder* recorder)
+	noexcept;
+
 	/**
 	 * \brief Updates the current frame in the game loop.
 	 * 
+	 * The simulation runs in fixed-length ticks regardless of the frame rate.
+	 * Time elapsed since the last frame is added to an accumulator, and as many
+	 * whole ticks as fit in it are run before drawing. Entities are then drawn
+	 * interpolated by the leftover fraction of a tick, so movement looks smooth
+	 * at any frame rate while gameplay speed stays the same.
+	 * 
 	 * \param window Game window to display new frame.
+	 * \param elapsed Real time since the last frame.
+	 */
+	void
+	updateFrame(
+		sf::RenderWindow&              window, 
+		const std::chrono::nanoseconds elapsed
+	);
+
+	/**
+	 * \brief Runs one simulation tick.
+	 * 
+	 * Every entity goes through the AI phase, then the movement phase, with 
+	 * each phase running over all the entities before the next one starts.
+	 * The AI phase is split across all cores.
+	 */
+	void
+	tick();
+
+	/**
+	 * \brief Draws the area map and the entities around the player on the 
+	 * game window.
+	 * 
+	 * The camera follows the player and only draws the tiles and entities in 
+	 * its view. Entities only queue render commands, which are then sorted and
+	 * drawn in one pass, apart from the simulation.
+	 * 
+	 * \param window Game window.
+	 * \param alpha How far the game is between the last tick and the next one,
+	 * from 0 to 1.
+	 */
+	void
+	render(sf::RenderWindow& window, const float alpha);
+
+	/**
+	 * \brief Gets the game's entities, to spawn or despawn entities at runtime
+	 * with \link EntityMake.
+	 * 
+	 * \return All the game's entities.
+	 */
+	EntityRegistry&
+	entities()
+	noexcept;
+
+	/**
+	 * \brief Gets the area map the game takes place in.
+	 * 
+	 * \return Area map that entities collide with.
+	 */
+	const World&
+	world()
+	const noexcept;
+
+	/**
+	 * \brief Lets go of the game's textures before exiting, since the game 
+	 * outlives SFML's graphics context otherwise.
 	 */
 	void
-	updateFrame(sf::RenderWindow& window);
+	releaseTextures()
+	noexcept;
+
+	/**
+	 * \brief Gets how long each phase of the last updated frame took, summed 
+	 * over all of the frame's ticks.
+	 * 
+	 * \return Phase timings.
+	 */
+	PhaseTimes
+	lastPhaseTimes()
+	const noexcept;
 	
 private:
 	/**
@@ -56,8 +165,33 @@ private:
 	/// Whether game is paused or running.
 	bool _is_playing;
 
-	std::unique_ptr< Entity > _player;
-	std::unique_ptr< Entity > _npc;
+	/// Workers the AI phase is split across.
+	util::JobSystem _jobs;
+
+	/// Area map the game takes place in. Declared before the entities, which
+	/// collide with it.
+	TutorialWorld  _world;
+
+	/// All the game's entities.
+	EntityRegistry _entities;
+
+	/// View of the area map around the player.
+	Camera         _camera;
+
+	/// Player-controlled entity.
+	EntityHandle   _player;
+
+	/// Timings of the last updated frame.
+	PhaseTimes     _phase_times;
+
+	/// Length of a simulation tick.
+	std::chrono::nanoseconds _tick_length;
+
+	/// Real time not yet simulated.
+	std::chrono::nanoseconds _accumulator;
+
+	/// Where the input of every tick is recorded, if anywhere.
+	InputRecorder*           _recorder;
 };
 
 } 
\ No newline at end of file
@@ -0,0 +1,75 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \copyright MIT License                                                   ///
+/// \author    Caylen Lee                                                    ///
+/// \date      2019                                                          ///
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <SFML/Window/Event.hpp>
+#include <SFML/Window/Window.hpp>
+
+#include <chrono>
+#include <vector>
+
+namespace nemo
+{
+
+/**
+ * \brief
+ * Window event tagged with when it was taken off the window's event queue.
+ */
+struct InputEvent
+{
+	using clock_t = std::chrono::steady_clock;
+
+	sf::Event           _event;     /// Event.
+	clock_t::time_point _timestamp; /// When the event was polled.
+};
+
+/**
+ * \brief
+ * Input stage of the game loop.
+ *
+ * SFML queues up window events between frames. Handling only one of them per
+ * frame lets input fall several frames behind whenever keys are pressed 
+ * faster than the frame rate. The pump instead drains the whole queue at the 
+ * start of each frame, so every input is handled within a frame of arriving.
+ *
+ * Usage example:
+ * \code
+ * 	nemo::InputPump input;
+ *
+ * 	while (window.isOpen()) {
+ * 		const std::vector< nemo::InputEvent >& events = input.drain(window);
+ * 		nemo::Controller::registerKeyEvents(events);
+ *
+ * 		for (const nemo::InputEvent& e : events) {
+ * 			if (e._event.type == sf::Event::Closed) {
+ * 				window.close();
+ * 			}
+ * 		}
+ * 	}
+ * \endcode
+ */
+class InputPump
+{
+public:
+	/**
+	 * \brief
+	 * Takes every pending event off a window's event queue.
+	 *
+	 * \param window
+	 * Window to poll.
+	 *
+	 * \return
+	 * Events in the order they happened. They stay valid until the next call.
+	 */
+	const std::vector< InputEvent >&
+	drain(sf::Window& window);
+
+private:
+	/// Events from the last drain, kept around to reuse the allocation.
+	std::vector< InputEvent > _events;
+};
+
+}
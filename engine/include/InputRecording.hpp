@@ -0,0 +1,216 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \copyright MIT License                                                   ///
+/// \author    Caylen Lee                                                    ///
+/// \date      2019                                                          ///
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "Controller.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace nemo
+{
+
+/**
+ * \brief
+ * Records the keys pressed on every simulation tick to a binary file.
+ *
+ * Since the simulation runs in fixed ticks, replaying a recording with
+ * \link InputReplay feeds the game the exact same input on the exact same
+ * ticks, which makes a play session reproducible without a player or window.
+ *
+ * The file holds a header with the tick rate, the seed of the game's random 
+ * numbers and the tick count, updated about once a second so a recording cut 
+ * short by a crash still replays. Then comes one record per tick on which the
+ * pressed keys changed: the tick number, the number of keys, then their codes,
+ * most recently pressed first.
+ *
+ * Usage example:
+ * \code
+ * 	nemo::InputRecorder recorder(
+ * 		"session.nemorec", nemo::constants::_tick_rate, entities.seed()
+ * 	);
+ *
+ * 	while (playing) {
+ * 		recorder.recordTick();
+ * 		game.tick();
+ * 	}
+ * \endcode
+ */
+class InputRecorder
+{
+public:
+	/**
+	 * \brief
+	 * Starts recording to a file.
+	 *
+	 * \param file         File to record to. Overwritten if it exists.
+	 * \param tick_rate    Simulation ticks per second.
+	 * \param seed         Seed of the entities' random numbers, without which
+	 *                     the recording plays out differently.
+	 */
+	InputRecorder(
+		const std::filesystem::path& file, 
+		const unsigned               tick_rate,
+		const std::uint64_t          seed
+	);
+
+	/**
+	 * \brief
+	 * Finishes the recording.
+	 */
+	~InputRecorder();
+
+	/**
+	 * \brief
+	 * Records the keys pressed for the upcoming tick.
+	 */
+	void
+	recordTick();
+
+	/**
+	 * \brief
+	 * Indicate whether the recording is being written successfully.
+	 *
+	 * \return
+	 * True if yes, false if the file couldn't be opened or written to.
+	 */
+	bool
+	isRecording()
+	const noexcept;
+
+private:
+	/**
+	 * \brief
+	 * Writes the number of ticks recorded so far into the header and flushes
+	 * the file.
+	 */
+	void
+	updateHeader();
+
+	/// Recording file.
+	std::ofstream                  _file;
+
+	/// Number of ticks recorded so far.
+	std::uint32_t                  _num_ticks;
+
+	/// Ticks between header updates.
+	std::uint32_t                  _header_interval;
+
+	/// Keys pressed on the last recorded tick.
+	Controller::pressed_keys_t     _last_keys;
+
+	/// Number of keys pressed on the last recorded tick.
+	std::size_t                    _num_last_keys;
+};
+
+/**
+ * \brief
+ * Replays the keys pressed on every simulation tick from a file recorded by
+ * \link InputRecorder.
+ *
+ * Usage example:
+ * \code
+ * 	nemo::InputReplay replay("session.nemorec");
+ * 	game.setTickRate(replay.tickRate());
+ * 	game.entities().seed(replay.seed());
+ *
+ * 	while (replay.replayTick()) {
+ * 		game.tick();
+ * 	}
+ * \endcode
+ */
+class InputReplay
+{
+public:
+	/**
+	 * \brief
+	 * Loads a recording.
+	 *
+	 * \param file
+	 * Recording file. If it can't be read, the replay is empty. If it was cut
+	 * short, e.g. by a crash, the ticks up to the cut are replayed.
+	 */
+	InputReplay(const std::filesystem::path& file);
+
+	/**
+	 * \brief
+	 * Presses the recorded keys for the next tick.
+	 *
+	 * \return
+	 * True if a tick was replayed, false if the recording has ended.
+	 */
+	bool
+	replayTick()
+	noexcept;
+
+	/**
+	 * \brief
+	 * Gets the tick rate the recording was made at.
+	 *
+	 * \return
+	 * Simulation ticks per second.
+	 */
+	unsigned
+	tickRate()
+	const noexcept;
+
+	/**
+	 * \brief
+	 * Gets the length of the recording.
+	 *
+	 * \return
+	 * Number of ticks recorded.
+	 */
+	std::uint32_t
+	numTicks()
+	const noexcept;
+
+	/**
+	 * \brief
+	 * Gets the seed of the entities' random numbers during the recording.
+	 *
+	 * \return
+	 * Seed to give the entities before replaying.
+	 */
+	std::uint64_t
+	seed()
+	const noexcept;
+
+private:
+	/**
+	 * \brief
+	 * Keys pressed from one tick onwards.
+	 */
+	struct Record
+	{
+		std::uint32_t              _tick;     /// First tick with these keys.
+		Controller::pressed_keys_t _keys;     /// Keys pressed.
+		std::size_t                _num_keys; /// Number of keys pressed.
+	};
+
+	/// Changes in the pressed keys, in tick order.
+	std::vector< Record > _records;
+
+	/// Next record to apply.
+	std::size_t           _next_record;
+
+	/// Next tick to replay.
+	std::uint32_t         _tick;
+
+	/// Number of ticks recorded.
+	std::uint32_t         _num_ticks;
+
+	/// Ticks per second the recording was made at.
+	unsigned              _tick_rate;
+
+	/// Seed of the entities' random numbers during the recording.
+	std::uint64_t         _seed;
+};
+
+}
@@ -0,0 +1,108 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \copyright MIT License                                                   ///
+/// \author    Caylen Lee                                                    ///
+/// \date      2019                                                          ///
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace nemo
+{
+
+/**
+ * \brief
+ * Request to draw one textured or solid-coloured rectangle.
+ */
+struct RenderCommand
+{
+	const sf::Texture* _texture;      /// Texture to draw from, or nullptr.
+	float              _depth;        /// Commands with more depth go on top.
+	sf::FloatRect      _bounds;       /// Where to draw, in world coordinates.
+	sf::IntRect        _texture_rect; /// Part of the texture to draw.
+	sf::Color          _color;        /// Colour multiplied with the texture.
+};
+
+/**
+ * \brief
+ * List of everything to draw in a frame, drawn all at once.
+ *
+ * Sprites push render commands instead of drawing straight to the window.
+ * When the frame is submitted, the commands are sorted by depth, then by
+ * texture, so draw order no longer depends on the order the commands were
+ * pushed in, and consecutive commands using the same texture are drawn in a
+ * single draw call.
+ *
+ * Usage example:
+ * \code
+ * 	nemo::RenderQueue queue;
+ *
+ * 	registry.render(queue, alpha);
+ * 	queue.submit(window);
+ * \endcode
+ */
+class RenderQueue
+{
+public:
+	/**
+	 * \brief
+	 * Adds a command to the frame.
+	 *
+	 * \param command
+	 * Render command.
+	 */
+	void
+	push(const RenderCommand& command);
+
+	/**
+	 * \brief
+	 * Gets the number of commands in the frame.
+	 *
+	 * \return
+	 * Number of commands.
+	 */
+	std::size_t
+	size()
+	const noexcept;
+
+	/**
+	 * \brief
+	 * Discards all the commands in the frame without drawing them.
+	 */
+	void
+	clear()
+	noexcept;
+
+	/**
+	 * \brief
+	 * Draws all the commands in the frame, then clears it.
+	 *
+	 * Commands of equal depth are drawn in the order they were pushed, unless
+	 * grouping them by texture reorders them.
+	 *
+	 * \param target
+	 * Window or texture to draw on.
+	 *
+	 * \return
+	 * Number of draw calls made.
+	 */
+	std::size_t
+	submit(sf::RenderTarget& target);
+
+private:
+	/// Commands of the frame.
+	std::vector< RenderCommand > _commands;
+
+	/// Quads of the commands being drawn. Kept between frames to reuse its
+	/// memory.
+	std::vector< sf::Vertex >    _vertices;
+};
+
+}
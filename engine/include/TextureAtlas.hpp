@@ -0,0 +1,218 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \copyright MIT License                                                   ///
+/// \author    Caylen Lee                                                    ///
+/// \date      2019                                                          ///
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "type/RowColumnIndex.hpp"
+
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Texture.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace nemo
+{
+
+/**
+ * \brief
+ * Where a tile ended up in a \link TextureAtlas.
+ */
+struct AtlasRegion
+{
+	std::size_t _page; /// Atlas page the tile is on.
+	sf::IntRect _rect; /// Pixel rectangle of the tile on the page.
+};
+
+/**
+ * \brief
+ * Large textures combining many tilesets and character sheets.
+ *
+ * Every texture switch breaks a batch of quads into another draw call, so a
+ * scene drawing from several small sheets costs several draw calls even when
+ * everything in it could be drawn at once. An atlas packs the sheets into as
+ * few pages as fit, so a whole scene draws from one or two textures.
+ *
+ * Sheets are added first, then packed all at once. Each sheet is kept in one
+ * piece on one page, shelf by shelf, tallest sheets first, with a transparent
+ * gutter around it so filtering doesn't bleed neighbouring sheets into it. 
+ * Packing fills a lookup table from every sheet's tile indices to their 
+ * rectangles in the atlas, so finding a tile costs one table read. The sheets'
+ * images are released once uploaded.
+ *
+ * Usage example:
+ * \code
+ * 	auto atlas = std::make_shared< nemo::TextureAtlas >();
+ * 	const auto urban = atlas->addSheet("urban.png", 16);
+ * 	const auto hero = atlas->addSheet("hero.png", 32);
+ *
+ * 	if (urban && atlas->pack()) {
+ * 		nemo::UrbanTilemap tileset(atlas, *urban);
+ * 	}
+ * \endcode
+ */
+class TextureAtlas
+{
+public:
+	/// Identifier of a sheet in the atlas.
+	using sheet_t = std::size_t;
+
+	/**
+	 * \brief
+	 * Creates an empty atlas.
+	 *
+	 * \param page_size
+	 * Width and height of a page, in pixels. Capped to the largest texture the
+	 * graphics card supports.
+	 */
+	explicit TextureAtlas(const unsigned page_size = 2048);
+
+	/**
+	 * \brief
+	 * Adds a sheet from an image file, to be packed with \link pack.
+	 *
+	 * \param file                File of the sheet's image.
+	 * \param tile_side_length    Width and height of a tile in the sheet, in
+	 *                            pixels.
+	 *
+	 * \return
+	 * Sheet's identifier, or nothing if the image couldn't be loaded, is
+	 * larger than a page, or the atlas is already packed.
+	 */
+	std::optional< sheet_t >
+	addSheet(const std::filesystem::path& file, const int tile_side_length);
+
+	/**
+	 * \brief
+	 * Adds a sheet, to be packed with \link pack.
+	 *
+	 * \param image               Sheet's image.
+	 * \param tile_side_length    Width and height of a tile in the sheet, in
+	 *                            pixels.
+	 *
+	 * \return
+	 * Sheet's identifier, or nothing if the image is larger than a page or the
+	 * atlas is already packed.
+	 */
+	std::optional< sheet_t >
+	addSheet(const sf::Image& image, const int tile_side_length);
+
+	/**
+	 * \brief
+	 * Packs all the sheets added so far into pages and uploads them, then 
+	 * releases the sheets' images. An atlas can only be packed once.
+	 *
+	 * \return
+	 * True if every page was uploaded, false otherwise.
+	 */
+	bool
+	pack();
+
+	/**
+	 * \brief
+	 * Gets the number of pages.
+	 *
+	 * \return
+	 * Number of pages, 0 until packed.
+	 */
+	std::size_t
+	numPages()
+	const noexcept;
+
+	/**
+	 * \brief
+	 * Gets a page's texture.
+	 *
+	 * \param page
+	 * Page, less than \link numPages.
+	 *
+	 * \return
+	 * Texture of the page.
+	 */
+	const sf::Texture&
+	page(const std::size_t page)
+	const noexcept;
+
+	/**
+	 * \brief
+	 * Gets the page a sheet was packed on.
+	 *
+	 * \param sheet
+	 * Sheet's identifier. The atlas must be packed.
+	 *
+	 * \return
+	 * Page of the sheet.
+	 */
+	std::size_t
+	pageOf(const sheet_t sheet)
+	const noexcept;
+
+	/**
+	 * \brief
+	 * Gets the number of rows and columns of tiles in a sheet.
+	 *
+	 * \param sheet
+	 * Sheet's identifier.
+	 *
+	 * \return
+	 * Sheet's dimensions, in tiles.
+	 */
+	type::RowColumnIndex
+	sheetSize(const sheet_t sheet)
+	const noexcept;
+
+	/**
+	 * \brief
+	 * Looks up where a tile of a sheet is in the atlas.
+	 *
+	 * \param sheet    Sheet's identifier. The atlas must be packed.
+	 * \param index    Row and column of the tile in the sheet.
+	 *
+	 * \return
+	 * Page and rectangle of the tile, or an empty rectangle if \a index is
+	 * outside the sheet.
+	 */
+	AtlasRegion
+	region(const sheet_t sheet, const type::RowColumnIndex index)
+	const noexcept;
+
+private:
+	/**
+	 * \brief
+	 * Sheet and where it was packed.
+	 */
+	struct Sheet
+	{
+		sf::Image    _image;            /// Sheet's image, until packed.
+		sf::Vector2u _size;             /// Size of the image, in pixels.
+		int          _tile_side_length; /// Size of the sheet's tiles.
+		unsigned     _num_rows;         /// Number of rows of tiles.
+		unsigned     _num_columns;      /// Number of columns of tiles.
+		std::size_t  _page;             /// Page the sheet is on.
+		std::size_t  _first_tile;       /// Sheet's first entry in the lookup.
+	};
+
+	/// Width and height of a page.
+	unsigned                                    _page_size;
+
+	/// Whether the sheets were packed.
+	bool                                        _is_packed;
+
+	/// Sheets in the order they were added.
+	std::vector< Sheet >                        _sheets;
+
+	/// Rectangle of every tile of every sheet, sheet by sheet, row by row.
+	std::vector< sf::IntRect >                  _tile_rects;
+
+	/// Page textures. Kept behind pointers, so references to them stay valid
+	/// when more pages are added.
+	std::vector< std::unique_ptr< sf::Texture > > _pages;
+};
+
+}
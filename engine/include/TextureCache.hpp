@@ -0,0 +1,157 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \copyright MIT License                                                   ///
+/// \author    Caylen Lee                                                    ///
+/// \date      2019                                                          ///
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <SFML/Graphics/Texture.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace nemo
+{
+
+/**
+ * \brief
+ * Textures shared by everything that draws, loaded once per file.
+ *
+ * Loading a file that's already cached returns the same texture without
+ * decoding or uploading it again. Textures are reference counted: they stay
+ * cached after their last user lets go of them, so switching back to an area
+ * map is free, until the cache grows over its memory budget. Then unused
+ * textures are evicted, least recently loaded first. Textures in use are never
+ * evicted, so the cache may stay over budget while they are.
+ *
+ * Usage example:
+ * \code
+ * 	std::shared_ptr< const sf::Texture > texture =
+ * 		nemo::TextureCache::getInstance().load("urban.png");
+ *
+ * 	if (!texture) {
+ * 		// Failed to load.
+ * 	}
+ * \endcode
+ */
+class TextureCache
+{
+public:
+	/**
+	 * \brief
+	 * Cache's effectiveness so far.
+	 */
+	struct Stats
+	{
+		std::size_t _hits;         /// Loads that found the texture cached.
+		std::size_t _misses;       /// Loads that read the texture from file.
+		std::size_t _evictions;    /// Textures evicted to stay within budget.
+		std::size_t _num_textures; /// Textures currently cached.
+		std::size_t _bytes;        /// Memory of the cached textures.
+	};
+
+	/**
+	 * \brief
+	 * Gets the cache shared by the whole game.
+	 *
+	 * \return
+	 * Texture cache.
+	 */
+	static TextureCache&
+	getInstance();
+
+	/**
+	 * \brief
+	 * Creates an empty cache.
+	 *
+	 * \param budget
+	 * Most memory to keep textures in, in bytes.
+	 */
+	explicit TextureCache(const std::size_t budget = 256 << 20);
+
+	/**
+	 * \brief
+	 * Gets the texture of an image file, loading it if it isn't cached.
+	 *
+	 * \param file
+	 * Image file.
+	 *
+	 * \return
+	 * Texture, or nullptr if it couldn't be loaded.
+	 */
+	std::shared_ptr< const sf::Texture >
+	load(const std::filesystem::path& file);
+
+	/**
+	 * \brief
+	 * Changes the memory budget, evicting unused textures to fit it.
+	 *
+	 * \param budget
+	 * Most memory to keep textures in, in bytes.
+	 */
+	void
+	setBudget(const std::size_t budget);
+
+	/**
+	 * \brief
+	 * Evicts every unused texture.
+	 */
+	void
+	clear();
+
+	/**
+	 * \brief
+	 * Gets the cache's hit and miss counts and memory use.
+	 *
+	 * \return
+	 * Cache statistics.
+	 */
+	Stats
+	stats()
+	const;
+
+private:
+	/**
+	 * \brief
+	 * Cached texture.
+	 */
+	struct Entry
+	{
+		std::shared_ptr< sf::Texture > _texture;   /// Texture.
+		std::size_t                    _bytes;     /// Texture's memory.
+		std::uint64_t                  _last_load; /// When last loaded.
+	};
+
+	/**
+	 * \brief
+	 * Evicts unused textures, least recently loaded first, until the cache
+	 * fits in a budget. The cache must be locked.
+	 *
+	 * \param budget
+	 * Memory to fit the cache in, in bytes.
+	 */
+	void
+	evict(const std::size_t budget);
+
+	/// Textures by file path.
+	std::unordered_map< std::string, Entry > _entries;
+
+	/// Most memory to keep textures in.
+	std::size_t                              _budget;
+
+	/// Hits, misses and memory use.
+	Stats                                    _stats;
+
+	/// Number of loads so far, used as a clock for eviction.
+	std::uint64_t                            _num_loads;
+
+	/// Guards everything, so textures can be loaded from any thread.
+	mutable std::mutex                       _mutex;
+};
+
+}
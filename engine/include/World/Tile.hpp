@@ -7,7 +7,10 @@
 
 #include <SFML/Graphics/RenderWindow.hpp>
 
-#include <vector>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 
 namespace nemo
 {
@@ -25,57 +28,92 @@ namespace type {
  * on only the tiles' metadata, which is everything about the tiles except the 
  * sprites themselves:
  * 
- *     1. Whether a character can walk into this tile i.e. isn't a wall or a
- *        closed space.
- * 
- *     2. Whether this tile is an exit that will take a character out of the 
+ *     1. Whether this tile is an exit that will take a character out of the 
  *        current area map, and where in the new area map it would take them to.
  * 
  *     2. Row and column indices of tile sprites from a tileset to render in the
  *        game window. The indices are not tied to a specific tilesets, so the 
  *        tileset can be easily swapped.
+ * 
+ * Whether a character can walk into a tile is not stored here but in a packed
+ * bitmap owned by the area map; see \link World::isWalkable.
+ * 
+ * Area maps keep one tile per distinct layer stack in a \link TilePalette 
+ * rather than one per cell. Most tiles have only a layer or two, so the layers
+ * are packed into 16 bits each and the first few are stored inside the tile 
+ * itself. Only tiles with more layers than that allocate.
  */
 class Tile
 {
 public:
+	/// Tileset index of a layer, with the tileset row in the high byte and the
+	/// column in the low byte, same as in compiled area maps.
+	using layer_t = std::uint16_t;
+
 	/**
 	 * \brief
-	 * Constructs an empty, non-walkable tile.
+	 * Constructs an empty tile.
 	 */
-	Tile();
+	Tile()
+	noexcept;
 
 	/**
 	 * \brief
-	 * Adds a row and column indices of a new tileset tile sprite to render
-	 * on screen.
+	 * Copies a tile's layers.
 	 * 
-	 * \param tile_idx
-	 * Row and column numbers of a new tileset tile to draw.
+	 * \param other
+	 * Tile to copy.
 	 */
-	void
-	addTileIndex(const type::RowColumnIndex tile_idx);
+	Tile(const Tile& other);
 
 	/**
 	 * \brief
-	 * Allow/disallow characters from walking into this tile.
+	 * Takes a tile's layers, leaving it empty.
 	 * 
-	 * \param walkable
-	 * True to allow, false to disallow.
+	 * \param other
+	 * Tile to take from.
 	 */
-	void
-	allowWalk(const bool walkable)
+	Tile(Tile&& other)
 	noexcept;
 
 	/**
 	 * \brief
-	 * Indicate whether characters can walk into this tile.
+	 * Replaces the layers with another tile's.
+	 * 
+	 * \param other
+	 * Tile to copy or take from.
 	 * 
 	 * \return
-	 * True if yes, false otherwise.
+	 * This tile.
 	 */
-	bool 
-	isWalkable()
-	const noexcept;
+	Tile&
+	operator=(Tile other)
+	noexcept;
+
+	/**
+	 * \brief
+	 * Adds a row and column indices of a new tileset tile sprite to render
+	 * on screen.
+	 * 
+	 * \param tile_idx
+	 * Row and column numbers of a new tileset tile to draw. Both must be less
+	 * than 255, since compiled area maps reserve row and column 255.
+	 */
+	void
+	addTileIndex(const type::RowColumnIndex tile_idx);
+
+	/**
+	 * \brief
+	 * Adds a packed tileset index of a new tile sprite to render on screen.
+	 * 
+	 * Unlike \link addTileIndex, this does not look for duplicates, for 
+	 * loaders whose layers were already deduplicated, like compiled area maps.
+	 * 
+	 * \param layer
+	 * Packed tileset index of a new tileset tile to draw.
+	 */
+	void
+	addLayer(const layer_t layer);
 
 	/**
 	 * \brief
@@ -91,12 +129,83 @@ public:
 	drawSprite(sf::RenderWindow& window, const Tileset& tileset)
 	const;
 
-private:	
-	/// Indicate whether characters can walk into this tile.
-	bool _is_walkable;
-	
-	/// A collection of tiles to draw from a tileset via indices.
-	std::vector< type::RowColumnIndex > _tile_indices;
+	/**
+	 * \brief
+	 * Gets the number of tile sprites to render.
+	 * 
+	 * \return
+	 * Number of layers.
+	 */
+	std::size_t
+	numLayers()
+	const noexcept;
+
+	/**
+	 * \brief
+	 * Gets the packed tileset indices of the tile sprites to render, in the 
+	 * order they are drawn.
+	 * 
+	 * \return
+	 * \link numLayers packed tileset indices, bottommost sprite first.
+	 */
+	const layer_t*
+	layers()
+	const noexcept;
+
+	/**
+	 * \brief
+	 * Packs a tileset index into a layer.
+	 * 
+	 * \param tile_idx
+	 * Row and column of a tileset tile, both less than 256.
+	 * 
+	 * \return
+	 * Packed tileset index.
+	 */
+	static layer_t
+	packIndex(const type::RowColumnIndex tile_idx)
+	noexcept;
+
+	/**
+	 * \brief
+	 * Unpacks a layer into a tileset index.
+	 * 
+	 * \param layer
+	 * Packed tileset index.
+	 * 
+	 * \return
+	 * Row and column of the tileset tile.
+	 */
+	static type::RowColumnIndex
+	unpackIndex(const layer_t layer)
+	noexcept;
+
+private:
+	/**
+	 * \brief
+	 * Gets the size of the overflow buffer that holds a number of layers.
+	 * 
+	 * \param num_layers
+	 * Number of layers, more than \link _inline_capacity.
+	 * 
+	 * \return
+	 * Buffer size, in layers.
+	 */
+	static std::size_t
+	overflowCapacity(const std::size_t num_layers)
+	noexcept;
+
+	/// Most layers stored inside the tile.
+	static constexpr std::size_t _inline_capacity = 3;
+
+	/// Layers, while there are no more than \link _inline_capacity.
+	std::array< layer_t, _inline_capacity > _inline_layers;
+
+	/// Number of layers.
+	std::uint16_t                           _num_layers;
+
+	/// All of the layers, once there are more than \link _inline_capacity.
+	std::unique_ptr< layer_t[] >            _overflow_layers;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,113 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \copyright MIT License                                                   ///
+/// \author    Caylen Lee                                                    ///
+/// \date      2019                                                          ///
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "World/Tile.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace nemo
+{
+
+/**
+ * \brief
+ * Distinct tile sprite layer stacks of an area map.
+ * 
+ * Most area maps repeat a handful of layer stacks over and over, e.g. plain
+ * grass on most of the map. Instead of a tile per cell, an area map keeps each
+ * distinct stack once in a palette and stores a 16-bit palette id per cell.
+ * 
+ * Stacks are interned as they are built, one layer at a time, from the empty
+ * stack at \link _empty_id. Since a stack can only be reached from the stack 
+ * below its top layer, remembering which stack each (stack, layer) pair leads
+ * to is enough to never store the same stack twice.
+ * 
+ * Usage example:
+ * \code
+ * 	nemo::TilePalette palette;
+ * 	
+ * 	// Same id both times.
+ * 	const auto grass = palette.withLayer(nemo::TilePalette::_empty_id, 0x0000);
+ * 	const auto again = palette.withLayer(nemo::TilePalette::_empty_id, 0x0000);
+ * \endcode
+ */
+class TilePalette
+{
+public:
+	/// Index of a layer stack in the palette.
+	using id_t = std::uint16_t;
+
+	/// Id of the stack with no layers, which every palette has.
+	static constexpr id_t _empty_id = 0;
+
+	/// Most stacks a palette can hold, including the empty one.
+	static constexpr std::size_t _max_size = std::size_t(1) << 16;
+
+	/**
+	 * \brief
+	 * Constructs a palette holding only the empty stack.
+	 */
+	TilePalette();
+
+	/**
+	 * \brief
+	 * Gets the stack made by adding a layer on top of another stack, adding it
+	 * to the palette if it isn't there yet.
+	 * 
+	 * \param id       Stack to add the layer on top of.
+	 * \param layer    Packed tileset index of the layer to add.
+	 * 
+	 * Same as \link Tile::addTileIndex, adding a layer the stack already has 
+	 * leaves it unchanged.
+	 * 
+	 * \return
+	 * Id of the stack with the layer, or nullopt if the palette is full.
+	 */
+	std::optional< id_t >
+	withLayer(const id_t id, const Tile::layer_t layer);
+
+	/**
+	 * \brief
+	 * Gets a stack in the palette.
+	 * 
+	 * \param id
+	 * Id of the stack. Must be less than \link size.
+	 * 
+	 * \return
+	 * Tile holding the stack's layers.
+	 */
+	const Tile&
+	tile(const id_t id)
+	const noexcept;
+
+	/**
+	 * \brief
+	 * Gets the number of stacks in the palette.
+	 * 
+	 * \return
+	 * Number of stacks, including the empty one.
+	 */
+	std::size_t
+	size()
+	const noexcept;
+
+private:
+	/// Stacks, indexed by id.
+	std::vector< Tile >                      _tiles;
+
+	/// Stack reached by adding a layer, keyed by the stack id in the high 16 
+	/// bits and the layer in the low 16 bits.
+	std::unordered_map< std::uint32_t, id_t > _children;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+}
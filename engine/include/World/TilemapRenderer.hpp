@@ -0,0 +1,195 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \copyright MIT License                                                   ///
+/// \author    Caylen Lee                                                    ///
+/// \date      2019                                                          ///
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace nemo
+{
+
+class World;
+class Tile;
+class Tileset;
+namespace type {
+	class RowColumnIndex;
+}
+
+/**
+ * \brief
+ * Batched renderer for an area map's tiles.
+ *
+ * Drawing tiles one at a time through \link Tile::drawSprite costs a draw call
+ * per tile, which adds up to tens of thousands of draw calls a frame on large 
+ * area maps. This class instead bakes the tile sprites of each of the world's 
+ * chunks into a vertex array of textured quads, so the whole map is drawn with
+ * one draw call per chunk.
+ *
+ * The baked vertices are a snapshot of the world's tiles. Call \link update
+ * once per frame before drawing; it rebakes only the chunks whose revision 
+ * number changed since they were last baked, so modifying a tile at runtime 
+ * costs one chunk rebuild instead of a whole map rebuild. Changing the world's
+ * tileset rebakes every chunk.
+ *
+ * Usage example:
+ * \code
+ * 	nemo::TutorialWorld world;
+ * 	nemo::TilemapRenderer renderer(world);
+ *
+ * 	while (window.isOpen()) {
+ * 		renderer.update();
+ * 		window.clear();
+ * 		renderer.draw(window);
+ * 		window.display();
+ * 	}
+ * \endcode
+ */
+class TilemapRenderer
+{
+public:
+	/**
+	 * \brief
+	 * Constructs a renderer and bakes the tiles of an area map.
+	 *
+	 * \param world
+	 * Area map to render. It must outlive the renderer.
+	 */
+	TilemapRenderer(const World& world);
+
+	/**
+	 * \brief
+	 * Rebakes the vertices of the chunks that changed since they were last 
+	 * baked.
+	 *
+	 * \return
+	 * Number of chunks rebaked.
+	 */
+	std::size_t
+	update();
+
+	/**
+	 * \brief
+	 * Rebakes the vertices of every chunk in the area map.
+	 */
+	void
+	rebuild();
+
+	/**
+	 * \brief
+	 * Draws the baked tiles on the game's window.
+	 *
+	 * \param window
+	 * Game's render window, or any other render target.
+	 */
+	void
+	draw(sf::RenderTarget& window)
+	const;
+
+	/**
+	 * \brief
+	 * Draws the baked tiles within an area of the map on the game's window.
+	 *
+	 * \param window       Game's render window, or any other render target.
+	 * \param top_left     First row and column of tiles to draw.
+	 * \param num_tiles    Number of rows and columns of tiles to draw.
+	 * 
+	 * Tiles are culled by whole chunks, so tiles of partially visible chunks 
+	 * around the area's edges are drawn as well.
+	 */
+	void
+	draw(
+		sf::RenderTarget&          window,
+		const type::RowColumnIndex top_left,
+		const type::RowColumnIndex num_tiles
+	) const;
+
+	/**
+	 * \brief
+	 * Gets the area map that this renderer draws.
+	 * 
+	 * \return
+	 * Area map.
+	 */
+	const World&
+	world()
+	const noexcept;
+
+	/**
+	 * \brief
+	 * Gets the number of draw calls that \link draw issues.
+	 *
+	 * \return
+	 * Number of draw calls per frame.
+	 */
+	std::size_t
+	drawCalls()
+	const noexcept;
+
+private:
+	/**
+	 * \brief
+	 * Baked vertices of one chunk of the area map.
+	 */
+	struct ChunkBatch
+	{
+		sf::VertexArray _vertices; /// Textured quads, in drawing order.
+		unsigned        _revision; /// Chunk revision the quads were baked from.
+	};
+
+	/**
+	 * \brief
+	 * Matches the number of batches to the area map's number of chunks.
+	 * 
+	 * \return
+	 * True if the batches had to be reallocated, false otherwise.
+	 */
+	bool
+	fitToWorld();
+
+	/**
+	 * \brief
+	 * Rebakes the vertices of one chunk.
+	 *
+	 * \param chunk_index    Row and column of the chunk, in chunks.
+	 * \param batch          Batch to rebake.
+	 */
+	void
+	bakeChunk(const type::RowColumnIndex chunk_index, ChunkBatch& batch);
+
+	/**
+	 * \brief
+	 * Appends a textured quad for each sprite layer of a tile.
+	 *
+	 * \param world_index    Row and column of the tile in the area map.
+	 * \param tile           Tile to bake.
+	 * \param tileset        Tileset the tile's sprites come from.
+	 * \param vertices       Vertex array to append to.
+	 */
+	static void
+	appendTile(
+		const type::RowColumnIndex world_index,
+		const Tile&                tile,
+		const Tileset&             tileset,
+		sf::VertexArray&           vertices
+	);
+
+	/// Area map to render.
+	const World&              _world;
+
+	/// Baked chunks, in the same row-major order as the area map's chunks.
+	std::vector< ChunkBatch > _batches;
+
+	/// Number of columns of chunks the batches were allocated for.
+	unsigned                  _num_chunk_columns;
+
+	/// Revision of the world's tileset the batches were baked from.
+	unsigned                  _tileset_revision;
+};
+
+}
@@ -5,12 +5,19 @@
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 
+#include "TextureAtlas.hpp"
+
 #include <SFML/Graphics/Sprite.hpp>
 #include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Vertex.hpp>
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <filesystem>
 #include <string_view>
+#include <vector>
 
 namespace nemo
 {
@@ -38,9 +45,31 @@ public:
 
 	/**
 	 * \brief
+	 * Loads a tileset image. Tilesets of the same image share one texture 
+	 * through the \link TextureCache.
+	 * 
+	 * \param file
+	 * Tileset image file.
+	 * 
+	 * \throw
+	 * std::ios_base::failure if the texture fails to load from the file for any
+	 * reasons.
 	 */
 	Tileset(const std::filesystem::path& file);
 
+	/**
+	 * \brief
+	 * Draws a tileset from an atlas page instead of its own texture, so the 
+	 * tiles batch with everything else on that page.
+	 * 
+	 * \param atlas    Packed atlas the tileset image was added to.
+	 * \param sheet    Tileset image's sheet in \a atlas.
+	 */
+	Tileset(
+		std::shared_ptr< const TextureAtlas > atlas, 
+		const TextureAtlas::sheet_t           sheet
+	);
+
 	/**
 	 * \brief 
 	 * Set the Tile Pixel Size object
@@ -49,24 +78,100 @@ public:
 	 */
 	void
 	setTilePixelSize(const int length);
-	
+
 	/**
 	 * \brief
 	 * 
 	 * \param index
 	 * Row and column the tile is located in the tileset image.
-	 * 
-	 * \throw
-	 * std::ios_base::failure if the texture fails to load from the file for any
-	 * reasons.
 	 */
 	sf::Sprite
 	getTileSprite(const type::RowColumnIndex index)
 	const;
 
+	/**
+	 * \brief
+	 * Gets the portion of the tileset image that a tile sprite occupies.
+	 * 
+	 * \param index
+	 * Row and column the tile is located in the tileset image.
+	 * 
+	 * \return
+	 * Pixel rectangle of the tile sprite in the tileset texture.
+	 */
+	sf::IntRect
+	getTileRect(const type::RowColumnIndex index)
+	const noexcept;
+
+	/**
+	 * \brief
+	 * Writes a quad for each tile sprite of a stack of layers drawn over one 
+	 * square on screen, straight into a vertex buffer.
+	 * 
+	 * Texture coordinates come from a table built when the tileset is loaded,
+	 * so this costs one table read per layer, without building sprites or 
+	 * rectangles. Indices outside the tileset are skipped.
+	 * 
+	 * \param layers      Packed row and column of each layer's tile in the 
+	 *                    tileset image, bottommost first; see 
+	 *                    \link Tile::layer_t.
+	 * \param count       Number of layers in \a layers.
+	 * \param top_left    Top-left corner of the square to draw the tiles on.
+	 * \param length      Width and height of the square.
+	 * \param vertices    Buffer with room for 4 vertices per layer.
+	 * 
+	 * \return
+	 * Number of quads written.
+	 */
+	std::size_t
+	writeQuads(
+		const std::uint16_t* layers,
+		const std::size_t    count,
+		const sf::Vector2f   top_left,
+		const float          length,
+		sf::Vertex*          vertices
+	) const noexcept;
+
+	/**
+	 * \brief
+	 * Gets the tileset image, for renderers that batch many tiles into a single
+	 * draw call.
+	 * 
+	 * \return
+	 * Tileset texture.
+	 */
+	const sf::Texture&
+	texture()
+	const noexcept;
+
 private:
-	sf::Texture _texture;
-	int         _tile_side_length;
+	/**
+	 * \brief
+	 * Texture coordinates of a tile sprite's corners.
+	 */
+	struct TexCoords
+	{
+		sf::Vector2f _top_left;     /// Top-left corner.
+		sf::Vector2f _bottom_right; /// Bottom-right corner.
+	};
+
+	/**
+	 * \brief
+	 * Rebuilds the texture coordinate table after the tile size or the texture
+	 * the tiles are drawn from has changed.
+	 */
+	void
+	buildTexCoords();
+
+	std::shared_ptr< const sf::Texture >  _texture; /// Null with an atlas.
+	int                                   _tile_side_length;
+	std::shared_ptr< const TextureAtlas > _atlas; /// Atlas to draw from, if any.
+	TextureAtlas::sheet_t                 _sheet; /// Sheet in \a _atlas.
+	unsigned                              _num_rows;    /// Rows of tiles.
+	unsigned                              _num_columns; /// Columns of tiles.
+
+	/// Texture coordinates of every tile, row by row.
+	std::vector< TexCoords >              _tex_coords;
 };
 
 /**
@@ -76,6 +181,10 @@ class UrbanTilemap : public Tileset
 {
 public:
 	UrbanTilemap();
+	UrbanTilemap(
+		std::shared_ptr< const TextureAtlas > atlas, 
+		const TextureAtlas::sheet_t           sheet
+	);
 };
 
 /**
@@ -85,19 +194,28 @@ class ForestTilemap : public Tileset
 {
 public:
 	ForestTilemap();
+	ForestTilemap(
+		std::shared_ptr< const TextureAtlas > atlas, 
+		const TextureAtlas::sheet_t           sheet
+	);
 };
 
 /**
  * \brief
  * Factory to create tilesets.
  * 
- * \param type
- * Which tileset to create.
+ * \param type     Which tileset to create.
+ * \param atlas    Unpacked atlas to add the tileset image to and pack, or 
+ *                 nullptr. The tileset then draws from the atlas and keeps it
+ *                 alive. If packing fails, it draws from its own texture.
  * 
  * \return
- * Tileset.
+ * Tileset, or nullptr if \a type is unknown.
  */
 std::unique_ptr< Tileset >
-makeTileset(const std::string_view& type);
+makeTileset(
+	const std::string_view&                type, 
+	const std::shared_ptr< TextureAtlas >& atlas = nullptr
+);
 
 } 
\ No newline at end of file
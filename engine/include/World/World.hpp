@@ -5,47 +5,148 @@
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 
-#include <boost/multi_array.hpp>
+#include "World/TilePalette.hpp"
+#include "type/RowColumnIndex.hpp"
+#include "type/Vector2.hpp"
+
 #include <SFML/Graphics/RenderWindow.hpp>
 
 #include <memory>
 #include <unordered_map>
 #include <filesystem>
+#include <string>
 #include <string_view>
+#include <vector>
+#include <optional>
+#include <cstdint>
+#include <cstddef>
 
 namespace nemo
 {
 
-namespace type {
-	class RowColumnIndex;
-}
-
-class Tile;
 class Tileset;
 enum class TilesetType;
 
 /**
  * \brief
+ * Area map.
+ * 
+ * Tiles are stored in square chunks of \link constants::_chunk_side_length 
+ * tiles per side, as 16-bit ids into a \link TilePalette of distinct layer 
+ * stacks. Each chunk has a revision number, bumped when its tiles change, so 
+ * renderers only rebuild the chunks that changed.
+ * 
+ * Walkability is a separate bitmap, one bit per tile, with each row padded to
+ * whole 64-bit words. Tiles outside the area map are never walkable.
  */
 class World
 {
 public:
+	/**
+	 * \brief
+	 * Outcome of sweeping a box through the area map.
+	 */
+	struct SweepResult
+	{
+		/// How far the box can actually move, in pixels.
+		type::Vector2                         _displacement;
+
+		/// Whether the box was stopped before moving the full distance.
+		bool                                  _is_blocked;
+
+		/// Non-walkable tile that stopped the box. This is nullopt if the box 
+		/// wasn't stopped or was stopped by the edge of the area map.
+		std::optional< type::RowColumnIndex > _contact;
+	};
+
 	virtual
-	~World() = default;
+	~World();
 
 	/**
 	 * \brief
+	 * Loads an area map from a file.
+	 * 
+	 * \param file
+	 * Path to the area map file. Files with the .nemomap extension are loaded 
+	 * as compiled area maps (see \link compile); any other file as json. On 
+	 * failure, the error is logged and the area map is left empty.
 	 */
 	World(const std::filesystem::path& file);
 
 	/**
 	 * \brief
+	 * Compiles a json area map into the binary .nemomap format.
+	 * 
+	 * \param json_file        Path to the json area map to read.
+	 * \param compiled_file    Path to the compiled area map to write.
+	 * 
+	 * Meant to be run offline, e.g. through the nemomapc tool.
+	 * 
+	 * \return
+	 * True if the compiled area map was written, false otherwise.
 	 */
-	Tile&
-	getTile(const type::RowColumnIndex world_index);
+	static bool
+	compile(
+		const std::filesystem::path& json_file, 
+		const std::filesystem::path& compiled_file
+	);
 
 	/**
 	 * \brief
+	 * Adds a tile sprite on top of a tile's sprites.
+	 * 
+	 * \param world_index    Row and column of the tile in the area map.
+	 * \param tile_idx       Row and column numbers of the tileset tile to 
+	 *                       draw. Both must be less than 255, since 
+	 *                       compiled area maps reserve row and column 255.
+	 * 
+	 * Bumps the revision of the tile's chunk, unless the tile already has the
+	 * sprite.
+	 * 
+	 * \return
+	 * False if the tile is outside the area map or the palette has no room for
+	 * the new stack, in which case nothing is changed.
+	 */
+	bool
+	addTileIndex(
+		const type::RowColumnIndex world_index, 
+		const type::RowColumnIndex tile_idx
+	);
+
+	/**
+	 * \brief
+	 * Gets the palette id of a tile's sprite layer stack.
+	 * 
+	 * \param world_index
+	 * Row and column of the tile in the area map.
+	 * 
+	 * \return
+	 * Id into \link palette.
+	 */
+	TilePalette::id_t
+	paletteId(const type::RowColumnIndex world_index)
+	const;
+
+	/**
+	 * \brief
+	 * Gets the distinct sprite layer stacks of the area map's tiles.
+	 * 
+	 * \return
+	 * Palette.
+	 */
+	const TilePalette&
+	palette()
+	const noexcept;
+
+	/**
+	 * \brief
+	 * Gets a tile's sprite layer stack.
+	 * 
+	 * \param world_index
+	 * Row and column of the tile in the area map.
+	 * 
+	 * \return
+	 * Palette entry shared by every tile with the same stack.
 	 */
 	const Tile&
 	getTile(const type::RowColumnIndex world_index)
@@ -53,21 +154,325 @@ public:
 
 	/**
 	 * \brief
+	 * Changes the tileset that the tiles draw their sprites from.
+	 * 
+	 * \param type
+	 * Tileset name, e.g. "urban". The tileset is loaded by the first call to
+	 * \link tileset, so area maps that are never drawn don't need a graphics 
+	 * card. If it fails to load, the error is logged and the area map is left
+	 * without one, which only affects drawing.
 	 */
 	void
 	setTileset(const std::string_view& type);
 
+	/**
+	 * \brief
+	 * Lets go of the tileset and its textures while there is still a graphics 
+	 * context to release them in, e.g. before exiting. The tileset is loaded 
+	 * again if the area map is drawn afterwards.
+	 */
+	void
+	releaseTileset()
+	noexcept;
+
+	/**
+	 * \brief
+	 * Gets the number of rows and columns of tiles in the area map.
+	 * 
+	 * \return
+	 * Area map dimensions, in tiles.
+	 */
+	type::RowColumnIndex
+	size()
+	const noexcept;
+
+	/**
+	 * \brief
+	 * Gets the tileset that the area map's tiles draw their sprites from, 
+	 * loading it on the first call. Only call it from the thread that draws.
+	 * 
+	 * \return
+	 * Tileset, or nullptr if none has been set or it failed to load.
+	 */
+	const Tileset*
+	tileset()
+	const;
+
+	/**
+	 * \brief
+	 * Gets the revision number of the tileset.
+	 * 
+	 * The revision number changes every time \link tileset loads a tileset, 
+	 * so renderers can tell when texture coordinates they cached are stale.
+	 * 
+	 * \return
+	 * Tileset's revision number.
+	 */
+	unsigned
+	tilesetRevision()
+	const noexcept;
+
+	/**
+	 * \brief
+	 * Gets the number of rows and columns of chunks in the area map.
+	 * 
+	 * Chunks on the bottom and right edges of the area map may be only 
+	 * partially covered by tiles.
+	 * 
+	 * \return
+	 * Area map dimensions, in chunks.
+	 */
+	type::RowColumnIndex
+	chunkCount()
+	const noexcept;
+
+	/**
+	 * \brief
+	 * Gets the revision number of a chunk.
+	 * 
+	 * \param chunk_index
+	 * Row and column of the chunk, in chunks.
+	 * 
+	 * The revision number changes every time a tile in the chunk is modified 
+	 * via \link addTileIndex. A renderer can compare it with the 
+	 * revision it last built the chunk from to tell whether the chunk is dirty.
+	 * 
+	 * \return
+	 * Chunk's revision number.
+	 */
+	unsigned
+	chunkRevision(const type::RowColumnIndex chunk_index)
+	const noexcept;
+
+	/**
+	 * \brief
+	 * Allow/disallow characters from walking into a tile.
+	 * 
+	 * \param world_index    Row and column of the tile in the area map. 
+	 *                       Tiles outside the area map are ignored.
+	 * \param walkable       True to allow, false to disallow.
+	 */
+	void
+	allowWalk(const type::RowColumnIndex world_index, const bool walkable)
+	noexcept;
+
+	/**
+	 * \brief
+	 * Indicate whether characters can walk into a tile.
+	 * 
+	 * \param world_index
+	 * Row and column of the tile in the area map.
+	 * 
+	 * \return
+	 * True if yes, false otherwise or if the tile is outside the area map.
+	 */
+	bool
+	isWalkable(const type::RowColumnIndex world_index)
+	const noexcept;
+
+	/**
+	 * \brief
+	 * Indicate whether characters can walk into every tile of an area.
+	 * 
+	 * \param top_left     First row and column of the area.
+	 * \param num_tiles    Number of rows and columns of the area.
+	 * 
+	 * \return
+	 * True if all tiles in the area are walkable, false if any isn't or if the
+	 * area reaches outside the area map.
+	 */
+	bool
+	isWalkable(
+		const type::RowColumnIndex top_left, 
+		const type::RowColumnIndex num_tiles
+	) const noexcept;
+
+	/**
+	 * \brief
+	 * Moves a box through the area map until it runs into a non-walkable tile.
+	 * 
+	 * \param position        Top-left corner of the box, in pixels.
+	 * \param size            Width and height of the box, in pixels.
+	 * \param displacement    Distance to move the box by, in pixels.
+	 * 
+	 * The box is moved along the x-axis first, then along the y-axis. Along 
+	 * each axis, only the columns or rows of tiles that the box's leading edge
+	 * enters are tested, so the cost grows with the number of tiles crossed 
+	 * rather than with the distance in pixels. If the box runs into a 
+	 * non-walkable tile, it stops flush against it.
+	 * 
+	 * \return
+	 * How far the box can move, and the first tile that stopped it, if any.
+	 */
+	SweepResult
+	sweepBox(
+		const type::Vector2 position,
+		const type::Vector2 size,
+		const type::Vector2 displacement
+	) const noexcept;
+
+	/**
+	 * \brief
+	 * Counts the non-walkable tiles along a straight line.
+	 * 
+	 * \param from    Row and column of the tile the line starts at.
+	 * \param to      Row and column of the tile the line ends at.
+	 * 
+	 * Both end tiles are included. Lines along a single row are counted 64 
+	 * tiles at a time.
+	 * 
+	 * \return
+	 * Number of non-walkable tiles on the line.
+	 */
+	std::size_t
+	countBlocked(
+		const type::RowColumnIndex from, 
+		const type::RowColumnIndex to
+	) const noexcept;
+
 private:
-	using tile_array_t = boost::multi_array< Tile, 2 >;
-	
+	/// Streaming json area map parser.
+	class JsonLoader;
+
+	/**
+	 * \brief
+	 * Square block of tiles.
+	 */
+	struct Chunk
+	{
+		std::vector< TilePalette::id_t > _ids;      /// Tiles, row-major.
+		unsigned                         _revision; /// Bumped on every change.
+	};
+
+	/**
+	 * \brief
+	 * Loads the area map from a json file.
+	 * 
+	 * \param file
+	 * Path to the json area map. It's streamed, not parsed whole; on the first 
+	 * error, the area map is left empty.
+	 */
+	void
+	loadJson(const std::filesystem::path& file);
+
+	/**
+	 * \brief
+	 * Loads the area map from a memory-mapped compiled area map file.
+	 * 
+	 * \param file
+	 * Path to the compiled area map.
+	 */
+	void
+	loadCompiled(const std::filesystem::path& file);
+
 	/**
 	 * \brief
 	 */
 	void
 	resetToSize(const type::RowColumnIndex num_tiles);
 
-	tile_array_t               _tiles;
-	std::shared_ptr< Tileset > _tileset;
+	/**
+	 * \brief
+	 * Gets the chunk containing a tile.
+	 * 
+	 * \param world_index    Row and column of the tile in the area map.
+	 * \return               Chunk containing the tile.
+	 */
+	const Chunk&
+	getChunk(const type::RowColumnIndex world_index)
+	const;
+
+	/**
+	 * \brief
+	 * Gets the chunk containing a tile, to modify it.
+	 * 
+	 * \param world_index    Row and column of the tile in the area map.
+	 * \return               Chunk containing the tile.
+	 */
+	Chunk&
+	getChunk(const type::RowColumnIndex world_index);
+
+	/**
+	 * \brief
+	 * Indicate whether characters can walk into every tile of an area.
+	 * 
+	 * \param row         First row of the area. May be negative.
+	 * \param column      First column of the area. May be negative.
+	 * \param num_rows    Number of rows of the area.
+	 * \param num_cols    Number of columns of the area.
+	 * 
+	 * \return
+	 * Same as the public \link isWalkable for areas.
+	 */
+	bool
+	isAreaWalkable(
+		const long long row,
+		const long long column,
+		const long long num_rows,
+		const long long num_cols
+	) const noexcept;
+
+	/**
+	 * \brief
+	 * Finds the first non-walkable tile of an area that is inside the area map.
+	 * 
+	 * \param row         First row of the area. May be negative.
+	 * \param column      First column of the area. May be negative.
+	 * \param num_rows    Number of rows of the area.
+	 * \param num_cols    Number of columns of the area.
+	 * 
+	 * \return
+	 * Row and column of the tile, or nullopt if there is none.
+	 */
+	std::optional< type::RowColumnIndex >
+	findBlocked(
+		const long long row,
+		const long long column,
+		const long long num_rows,
+		const long long num_cols
+	) const noexcept;
+
+	/**
+	 * \brief
+	 * Gets the position of a tile within its chunk.
+	 * 
+	 * \param world_index    Row and column of the tile in the area map.
+	 * \return               Position in the chunk's row-major tile array.
+	 */
+	static std::size_t
+	offsetInChunk(const type::RowColumnIndex world_index)
+	noexcept;
+
+	/// Area map dimensions, in tiles.
+	unsigned                   _num_rows;
+	unsigned                   _num_columns;
+
+	/// Chunks of tiles, in row-major order.
+	std::vector< Chunk >       _chunks;
+
+	/// Distinct sprite layer stacks that the chunks' ids refer to.
+	TilePalette                _palette;
+
+	/// Number of columns of chunks.
+	unsigned                   _num_chunk_columns;
+
+	/// Walkability bitmap, in row-major order.
+	std::vector< std::uint64_t > _walkable;
+
+	/// Number of words per row in the walkability bitmap.
+	std::size_t                _walkable_words_per_row;
+
+	/// Name of the tileset.
+	std::string                _tileset_type;
+
+	/// Tileset, once loaded by \link tileset.
+	mutable std::shared_ptr< Tileset > _tileset;
+
+	/// Whether \link tileset tried loading the tileset.
+	mutable bool               _is_tileset_loaded;
+
+	/// Number of times the tileset was loaded.
+	mutable unsigned           _tileset_revision;
 };
 
 class TutorialWorld : public World
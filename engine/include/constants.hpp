@@ -15,7 +15,11 @@ const std::filesystem::path _asset_dir  = _root_dir  / "asset";
 const std::filesystem::path _sprite_dir = _asset_dir / "sprite";
 const std::filesystem::path _log_dir    = _root_dir  / "log";
 constexpr auto _tile_side_length        = 16;
+constexpr auto _chunk_side_length       = 32;
 constexpr auto _walking_speed           = 4;
 constexpr auto _running_speed           = 8;
+constexpr auto _tick_rate               = 30;
+constexpr auto _window_width            = 1280;
+constexpr auto _window_height           = 720;
 
 }
\ No newline at end of file
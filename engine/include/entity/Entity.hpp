@@ -8,12 +8,15 @@
 #include "ai/EntityAI.hpp"
 #include "sprite/EntitySprite.hpp"
 #include "Movement.hpp"
+#include "EntityRegistry.hpp"
 #include "attributes.hpp"
 #include "type/Vector2.hpp"
+#include "RenderQueue.hpp"
+#include "util/Random.hpp"
 
-#include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/System/Vector2.hpp>
 
-#include <memory>
+#include <cstddef>
 
 namespace nemo
 {
@@ -21,20 +24,30 @@ namespace nemo
 /**
  * \brief
  * Game entity.
+ * 
+ * An entity is a lightweight view of one entity's attributes in an 
+ * \link EntityRegistry, identified by its handle. It's cheap to copy and only 
+ * valid while its entity is in the registry.
  */
 class Entity
 {
 public:
-	virtual 
-	~Entity() = default;
-	
 	/**
-	 * \brief
+	 * \brief             Constructs a view of an entity in a registry.
+	 * 
+	 * \param registry    Registry the entity is in.
+	 * \param handle      Handle to the entity.
 	 */
-	Entity(
-		std::unique_ptr< ai::EntityAI >&&         ai,
-		std::unique_ptr< sprite::EntitySprite >&& sprite
-	);
+	Entity(EntityRegistry& registry, const EntityHandle handle)
+	noexcept;
+
+	/**
+	 * \brief     Gets entity's handle in its registry.
+	 * \return    Entity's handle.
+	 */
+	EntityHandle
+	handle()
+	const noexcept;
 
 	/**
 	 * \brief     Gets entity's current coordinates.
@@ -45,13 +58,37 @@ public:
 	const noexcept;
 
 	/**
-	 * \brief             Changes entity's current coordinates.
+	 * \brief          Gets entity's coordinates to draw it at, between where 
+	 *                 it was before and after the last movement phase.
+	 * 
+	 * \param alpha    How far the game is between the last simulation tick 
+	 *                 and the next one, from 0 to 1.
+	 * 
+	 * \return         Interpolated coordinates.
+	 */
+	sf::Vector2f
+	interpolatedPosition(const float alpha)
+	const noexcept;
+
+	/**
+	 * \brief             Changes entity's current coordinates. The entity is 
+	 *                    drawn moving there from where it was before the last
+	 *                    movement phase.
 	 * \param position    Entity's new coordinates.
 	 */
 	void
 	setPosition(const type::Vector2 position)
 	noexcept;
 
+	/**
+	 * \brief             Puts the entity at new coordinates without drawing it
+	 *                    moving there, e.g. right after spawning it.
+	 * \param position    Entity's new coordinates.
+	 */
+	void
+	teleport(const type::Vector2 position)
+	noexcept;
+
 	/**
 	 * \brief     Gets entity's movement handler.
 	 * \return    Entity's movement handler.
@@ -62,10 +99,11 @@ public:
 
 	/**
 	 * \brief             Changes entity's movement handler.
-	 * \param movement    Entity's new movement handler.
+	 * \param movement    Entity's new movement handler, e.g. attr::Immovable()
+	 *                    to keep it in place.
 	 */
 	void
-	setMovability(std::unique_ptr< attr::Movement >&& movement)
+	setMovability(const attr::Movement& movement)
 	noexcept;
 
 	/**
@@ -76,34 +114,105 @@ public:
 	speed()
 	const noexcept;
 
+	/**
+	 * \brief     Gets the movement entity's AI decided on for this frame.
+	 * \return    Entity's movement intent.
+	 */
+	attr::MovementIntent
+	intent()
+	const noexcept;
+
+	/**
+	 * \brief           Records the movement to carry out in the movement phase.
+	 * \param intent    Direction and distance to move the entity by.
+	 */
+	void
+	setIntent(const attr::MovementIntent intent)
+	noexcept;
+
+	/**
+	 * \brief     Gets whether the entity sets off walking this tick, if it 
+	 *            wanders; see \link attr::_wander_chance.
+	 * 
+	 * Drawn for every entity at once at the start of the AI phase, from the 
+	 * first number of the entity's random stream for this tick.
+	 * 
+	 * \return    True if it sets off, false otherwise.
+	 */
+	bool
+	wanders()
+	const noexcept;
+
+	/**
+	 * \brief     Gets the entity's own random numbers for this tick.
+	 * 
+	 * The numbers only depend on the registry's seed, the entity and the 
+	 * tick, so AIs drawing from them behave the same on every run with the
+	 * same seed, on any number of threads.
+	 * 
+	 * \return    Entity's random stream, positioned at the current tick.
+	 */
+	util::RandomStream
+	random()
+	const noexcept;
+
 	/**
 	 * \brief       Changes an entity's AI.
-	 * \param ai    New AI to swap in.
+	 * \param ai    New AI to swap in. It must outlive the entity's use of it.
 	 */
 	void
-	changeAI(std::unique_ptr< ai::EntityAI >&& ai);
+	changeAI(ai::EntityAI& ai)
+	noexcept;
+
+	/**
+	 * \brief     Gets entity's sprite renderer.
+	 * \return    Entity's sprite renderer.
+	 */
+	const sprite::EntitySprite&
+	sprite()
+	const noexcept;
 
 	/**
 	 * \brief           Changes an entity's sprite renderer
-	 * \param sprite    New sprite renderer to use.
+	 * \param sprite    New sprite renderer to use. It must outlive the entity's
+	 *                  use of it.
 	 */
 	void
-	changeSprite(std::unique_ptr< sprite::EntitySprite >&& sprite);
+	changeSprite(const sprite::EntitySprite& sprite)
+	noexcept;
 
 	/**
-	 * \brief           Updates the object for the game loop's current frame.
-	 * \param window    Game window.
+	 * \brief    Runs one simulation tick of only this entity: its AI decides 
+	 *           on an action, then the entity moves.
+	 * 
+	 * The game simulates every entity at once, in the registry's AI and 
+	 * movement phases; this is for running one on its own.
 	 */
 	void
-	updateObject(sf::RenderWindow &window);
+	simulate();
+
+	/**
+	 * \brief           Queues the drawing of only this entity for the current
+	 *                  frame.
+	 * \param queue     Render commands of the frame.
+	 * \param alpha     How far the game is between the last simulation tick 
+	 *                  and the next one, from 0 to 1.
+	 */
+	void
+	render(RenderQueue& queue, const float alpha)
+	const;
 
 private:
-	type::Vector2       _position; /// Current position.
-	attr::MovementSpeed _speed;    /// Movement speeds.
-	
-	std::unique_ptr< attr::Movement >       _movement; /// Handles movements.
-	std::unique_ptr< ai::EntityAI >         _ai;       /// AI.
-	std::unique_ptr< sprite::EntitySprite > _sprite;   /// Handles sprites.
+	/**
+	 * \brief     Gets the position of the entity in its registry's pools.
+	 * \return    Index of the entity.
+	 */
+	std::size_t
+	index()
+	const noexcept;
+
+	EntityRegistry* _registry; /// Registry the entity is in.
+	EntityHandle    _handle;   /// Handle to the entity.
 };
 
 } 
\ No newline at end of file
@@ -5,13 +5,13 @@
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 
-#include <memory>
+#include "Entity.hpp"
+
+#include <optional>
 
 namespace nemo
 {
 
-class Entity;
-
 /**
  * \brief
  * Enumeration identifiers used for generating entity objects.
@@ -22,20 +22,54 @@ enum class EntityID
 	TeenageBoy, /// Generic teenage boy.
 };
 
+/**
+ * \brief
+ * Spawns preset entities into and despawns them from a registry.
+ * 
+ * Entities of the same preset share the same AI and sprite renderer objects.
+ */
 class EntityMake
 {
 public:
-	using entity_ptr_t = std::unique_ptr< Entity >;
 	EntityMake() = delete;
 
-	static entity_ptr_t
-	entity(const EntityID what);
+	/**
+	 * \brief             Spawns a preset entity.
+	 * 
+	 * \param registry    Registry to spawn the entity into.
+	 * \param what        Preset to spawn.
+	 * \return            New entity, or nullopt if \a what is unknown.
+	 */
+	static std::optional< Entity >
+	entity(EntityRegistry& registry, const EntityID what);
+
+	/**
+	 * \brief             Spawns a player-controlled hero.
+	 * \param registry    Registry to spawn the entity into.
+	 * \return            New entity.
+	 */
+	static Entity
+	hero(EntityRegistry& registry);
 
-	static entity_ptr_t
-	hero();
+	/**
+	 * \brief             Spawns a randomly walking teenage boy.
+	 * \param registry    Registry to spawn the entity into.
+	 * \return            New entity.
+	 */
+	static Entity
+	teenageBoy(EntityRegistry& registry);
 
-	static entity_ptr_t
-	teenageBoy();
+	/**
+	 * \brief             Removes an entity spawned by any of the above.
+	 * 
+	 * \param registry    Registry the entity was spawned into.
+	 * \param handle      Handle to the entity.
+	 * \return            True if the entity was removed, false if it had 
+	 *                    already been.
+	 */
+	static bool
+	despawn(EntityRegistry& registry, const EntityHandle handle)
+	noexcept;
 };
 
 }
\ No newline at end of file
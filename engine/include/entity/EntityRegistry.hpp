@@ -0,0 +1,423 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \copyright MIT License                                                   ///
+/// \author    Caylen Lee                                                    ///
+/// \date      2019                                                          ///
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "Movement.hpp"
+#include "attributes.hpp"
+#include "type/Vector2.hpp"
+#include "RenderQueue.hpp"
+#include "util/JobSystem.hpp"
+#include "util/Random.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace nemo
+{
+
+class Entity;
+
+namespace ai {
+	class EntityAI;
+}
+
+namespace sprite {
+	class EntitySprite;
+}
+
+/**
+ * \brief
+ * Stable identifier of an entity in an \link EntityRegistry.
+ *
+ * A handle stays valid for as long as its entity is in the registry, no matter
+ * how many other entities are spawned or despawned. Once the entity is
+ * despawned, its handle never refers to another entity, even after the
+ * entity's slot is reused.
+ */
+struct EntityHandle
+{
+	std::uint32_t _index;      /// Slot of the entity in the registry.
+	std::uint32_t _generation; /// Number of times the slot had been reused.
+
+	/**
+	 * \brief        Overloads (==) operator.
+	 * \param rhs    Second operand.
+	 * \return       True if both handles refer to the same entity.
+	 */
+	bool
+	operator == (const EntityHandle rhs)
+	const noexcept;
+
+	/**
+	 * \brief        Overloads (!=) operator.
+	 * \param rhs    Second operand.
+	 * \return       True if the handles refer to different entities.
+	 */
+	bool
+	operator != (const EntityHandle rhs)
+	const noexcept;
+};
+
+/**
+ * \brief
+ * Storage of all the game entities.
+ *
+ * Entities' attributes are stored as a structure of arrays, with one
+ * contiguous pool per attribute and the i-th element of every pool belonging to
+ * the same entity. Despawning an entity moves the last entity into its place,
+ * so the pools never have holes and per-frame updates iterate over them
+ * linearly.
+ *
+ * Entities that can move come first in the pools and those that can't come
+ * last, so the movement phase only iterates over the first part and never 
+ * touches immovable entities at all.
+ *
+ * Behaviours, i.e. AIs and sprite renderers, aren't owned by the registry. 
+ * Entities hold references to them, so one behaviour object can be shared by 
+ * thousands of entities. They must outlive the entities using them. Movement 
+ * handlers are small values stored with each entity instead.
+ *
+ * Usage example:
+ * \code
+ * 	nemo::EntityRegistry registry;
+ * 	nemo::ai::RandomPedestrian ai;
+ * 	nemo::sprite::TeenageBoy sprite;
+ *
+ * 	const nemo::EntityHandle handle = registry.spawn(ai, sprite);
+ * 	registry.entity(handle).teleport(position);
+ *
+ * 	registry.runAI();
+ * 	registry.applyMovement();
+ * 	registry.render(queue, alpha);
+ * 	queue.submit(window);
+ * 	registry.despawn(handle);
+ * \endcode
+ */
+class EntityRegistry
+{
+public:
+	/**
+	 * \brief
+	 * Constructs an empty registry.
+	 */
+	EntityRegistry();
+
+	/**
+	 * \brief
+	 * Changes the area map that entities collide with.
+	 *
+	 * \param world
+	 * Area map, or nullptr to let entities move freely. It must outlive the
+	 * registry's use of it. Movable entities already in the registry switch to
+	 * it too.
+	 */
+	void
+	setWorld(const World* world)
+	noexcept;
+
+	/**
+	 * \brief
+	 * Adds a new entity at (0, 0) with default speeds. It's movable, and 
+	 * collides with the registry's area map if there is one.
+	 *
+	 * \param ai        Entity's AI.
+	 * \param sprite    Entity's sprite renderer.
+	 *
+	 * \return
+	 * Handle to the new entity.
+	 */
+	EntityHandle
+	spawn(ai::EntityAI& ai, const sprite::EntitySprite& sprite);
+
+	/**
+	 * \brief
+	 * Removes an entity.
+	 *
+	 * \param handle
+	 * Handle to the entity.
+	 *
+	 * Don't despawn entities while the registry is being updated.
+	 *
+	 * \return
+	 * True if the entity was removed, false if it wasn't in the registry.
+	 */
+	bool
+	despawn(const EntityHandle handle)
+	noexcept;
+
+	/**
+	 * \brief
+	 * Indicate whether an entity is still in the registry.
+	 *
+	 * \param handle
+	 * Handle to the entity.
+	 *
+	 * \return
+	 * True if yes, false otherwise.
+	 */
+	bool
+	contains(const EntityHandle handle)
+	const noexcept;
+
+	/**
+	 * \brief
+	 * Gets an entity by its handle.
+	 *
+	 * \param handle
+	 * Handle to the entity. The entity must be in the registry.
+	 *
+	 * \return
+	 * View of the entity.
+	 */
+	Entity
+	entity(const EntityHandle handle)
+	noexcept;
+
+	/**
+	 * \brief
+	 * Gets an entity by its position in the pools.
+	 *
+	 * \param i
+	 * Index of the entity, less than \link size. An entity's index changes when
+	 * entities are spawned or despawned or change movability, so keep handles
+	 * rather than indices.
+	 *
+	 * \return
+	 * View of the entity.
+	 */
+	Entity
+	at(const std::size_t i)
+	noexcept;
+
+	/**
+	 * \brief
+	 * Gets the number of entities in the registry.
+	 *
+	 * \return
+	 * Number of entities.
+	 */
+	std::size_t
+	size()
+	const noexcept;
+
+	/**
+	 * \brief
+	 * Preallocates the pools for a number of entities.
+	 *
+	 * \param capacity
+	 * Number of entities.
+	 */
+	void
+	reserve(const std::size_t capacity);
+
+	/**
+	 * \brief
+	 * Changes the seed of the entities' random numbers.
+	 *
+	 * \param seed
+	 * New seed. A game run twice with the same seed and input plays out the
+	 * same.
+	 */
+	void
+	seed(const std::uint64_t seed)
+	noexcept;
+
+	/**
+	 * \brief
+	 * Gets the seed of the entities' random numbers.
+	 *
+	 * \return
+	 * Current seed, to record along with the game's input.
+	 */
+	std::uint64_t
+	seed()
+	const noexcept;
+
+	/**
+	 * \brief
+	 * AI phase of a frame: lets every entity's AI decide on its action.
+	 * 
+	 * Whether each entity wanders this tick is drawn for all of them at once
+	 * first. AIs record movements as intents instead of moving their entities,
+	 * so no entity moves until \link applyMovement.
+	 */
+	void
+	runAI();
+
+	/**
+	 * \brief
+	 * AI phase of a frame, with the entities split across a pool of workers.
+	 * 
+	 * Safe because AIs only write to their own entity's intent.
+	 * 
+	 * \param jobs
+	 * Workers to run the AIs on.
+	 */
+	void
+	runAI(util::JobSystem& jobs);
+
+	/**
+	 * \brief
+	 * Movement phase of a frame: moves every entity according to its intent,
+	 * then clears the intent. Ends the tick, so entities draw new random 
+	 * numbers in the next AI phase.
+	 * 
+	 * Entities' positions from before moving are kept, so drawing can 
+	 * interpolate between the last two movement phases.
+	 */
+	void
+	applyMovement()
+	noexcept;
+
+	/**
+	 * \brief
+	 * Render phase of a frame: queues the drawing of every entity.
+	 * 
+	 * Only reads from the entities, so it doesn't need to wait for anything 
+	 * but the last movement phase.
+	 * 
+	 * \param queue     Render commands of the frame.
+	 * \param alpha     How far the game is between the last simulation tick 
+	 *                  and the next one, from 0 to 1.
+	 */
+	void
+	render(RenderQueue& queue, const float alpha = 1.f);
+
+private:
+	friend class Entity;
+
+	/**
+	 * \brief
+	 * Gets the position of an entity in the pools.
+	 *
+	 * \param handle
+	 * Handle to the entity. The entity must be in the registry.
+	 *
+	 * \return
+	 * Index of the entity.
+	 */
+	std::size_t
+	indexOf(const EntityHandle handle)
+	const noexcept;
+
+	/**
+	 * \brief
+	 * Changes an entity's movement handler, moving the entity to the other 
+	 * part of the pools if it starts or stops being able to move.
+	 *
+	 * \param handle      Handle to the entity. The entity must be in the 
+	 *                    registry.
+	 * \param movement    New movement handler.
+	 */
+	void
+	setMovement(const EntityHandle handle, const attr::Movement& movement)
+	noexcept;
+
+	/**
+	 * \brief
+	 * Swaps two entities' places in the pools. Their handles stay valid.
+	 *
+	 * \param a    Index of an entity.
+	 * \param b    Index of another entity, or the same one.
+	 */
+	void
+	swapEntities(const std::size_t a, const std::size_t b)
+	noexcept;
+
+	/**
+	 * \brief
+	 * Draws whether each of a range of entities wanders this tick, in one 
+	 * batch; see \link Entity::wanders.
+	 *
+	 * \param begin    Index of the first entity.
+	 * \param end      Index past the last entity.
+	 */
+	void
+	drawWanders(const std::size_t begin, const std::size_t end)
+	noexcept;
+
+	/**
+	 * \brief
+	 * Gets the identifier of an entity's random stream.
+	 *
+	 * \param handle
+	 * Handle to the entity.
+	 *
+	 * \return
+	 * Stream identifier.
+	 */
+	static std::uint64_t
+	streamId(const EntityHandle handle)
+	noexcept;
+
+	/**
+	 * \brief
+	 * Gets an entity's random stream for the current tick.
+	 *
+	 * \param handle
+	 * Handle to the entity.
+	 *
+	 * \return
+	 * Random stream.
+	 */
+	util::RandomStream
+	randomStream(const EntityHandle handle)
+	const noexcept;
+
+	/// Index into the pools of each slot's entity.
+	std::vector< std::uint32_t >                 _slot_indices;
+
+	/// Current generation of each slot.
+	std::vector< std::uint32_t >                 _slot_generations;
+
+	/// Slots of despawned entities, to be reused.
+	std::vector< std::uint32_t >                 _free_slots;
+
+	/// Handles, so an entity can be found from its index in the pools.
+	std::vector< EntityHandle >                  _handles;
+
+	/// Current coordinates.
+	std::vector< type::Vector2 >                 _positions;
+
+	/// Coordinates before the last movement phase.
+	std::vector< type::Vector2 >                 _previous_positions;
+
+	/// Movement speeds.
+	std::vector< attr::MovementSpeed >           _speeds;
+
+	/// Movements decided by the AIs for the current frame.
+	std::vector< attr::MovementIntent >          _intents;
+
+	/// Movement handlers.
+	std::vector< attr::Movement >                _movements;
+
+	/// AIs.
+	std::vector< ai::EntityAI* >                 _ais;
+
+	/// Sprite renderers.
+	std::vector< const sprite::EntitySprite* >   _sprites;
+
+	/// Identifiers of the random streams, to draw from in batches.
+	std::vector< std::uint64_t >                 _stream_ids;
+
+	/// Whether each entity wanders this tick, 1 if so.
+	std::vector< std::uint8_t >                  _wanders;
+
+	/// Number of movable entities, which are at the front of the pools.
+	std::size_t                                  _num_movable = 0;
+
+	/// Source of every entity's random stream.
+	util::Random                                 _random;
+
+	/// Number of movement phases run, i.e. ticks finished.
+	std::uint64_t                                _tick = 0;
+
+	/// Area map that entities collide with, if any.
+	const World*                                 _world = nullptr;
+};
+
+}
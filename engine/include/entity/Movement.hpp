@@ -5,6 +5,13 @@
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 
+#include "World/World.hpp"
+#include "attributes.hpp"
+#include "type/Vector2.hpp"
+#include "constants.hpp"
+
+#include <variant>
+
 namespace nemo {
 	class Entity; // Forward declaration.
 }
@@ -14,148 +21,250 @@ namespace nemo::attr
 
 /**
  * \brief
- * Handles an entity's movements.
+ * Allows an entity to move.
+ * 
+ * A movable constructed with an area map is collision-aware: each move sweeps
+ * the entity's hitbox through the map's walkable tiles via 
+ * \link World::sweepBox, stops it flush against the first non-walkable tile 
+ * or the map's edge, and reports that tile. The sweep tests only the tiles the
+ * hitbox's leading edge crosses, so it costs the same no matter how many 
+ * pixels a move covers. Without an area map, entities move freely.
  */
-class Movement
+class Movable
 {
 public:
-	virtual
-	~Movement() = default;
+	/// Movement phase must run for entities with this handler.
+	static constexpr bool _can_move = true;
 
 	/**
-	 * \brief           Pure virtual method to move a game entity left.
-	 * 
-	 * \param entity    Game entity to move.
-	 * \param speed     Amoung of distance to move \a entity by.
+	 * \brief
+	 * Constructs a movement handler that ignores the area map.
 	 */
-	virtual void
-	moveLeft(Entity& entity, const int speed)
-	const noexcept = 0;
+	Movable()
+	noexcept;
 
 	/**
-	 * \brief           Pure virtual method to move a game entity up.
+	 * \brief
+	 * Constructs a movement handler that collides with an area map's 
+	 * non-walkable tiles.
 	 * 
-	 * \param entity    Game entity to move.
-	 * \param speed     Amoung of distance to move \a entity by.
+	 * \param world     Area map to collide with. It must outlive the handler.
+	 * \param hitbox    Width and height of the entity's hitbox, in pixels. Its
+	 *                  top-left corner is at the entity's position.
 	 */
-	virtual void
-	moveUp(Entity& entity, const int speed)
-	const noexcept = 0;
+	Movable(
+		const World&        world,
+		const type::Vector2 hitbox = type::Vector2(
+			type::x_t(constants::_tile_side_length), 
+			type::y_t(constants::_tile_side_length)
+		)
+	) noexcept;
 
 	/**
-	 * \brief           Pure virtual method to move a game entity right.
-	 * 
-	 * \param entity    Game entity to move.
-	 * \param speed     Amoung of distance to move \a entity by.
+	 * \brief          Changes the area map to collide with.
+	 * \param world    Area map, or nullptr to move freely. It must outlive 
+	 *                 the handler.
 	 */
-	virtual void
-	moveRight(Entity& entity, const int speed)
-	const noexcept = 0;
+	void
+	setWorld(const World* world)
+	noexcept;
 
 	/**
-	 * \brief           Pure virtual method to move a game entity down.
+	 * \brief           Moves a game entity the way its AI decided to.
 	 * 
 	 * \param entity    Game entity to move.
-	 * \param speed     Amoung of distance to move \a entity by.
+	 * \param intent    Direction and distance to move \a entity by.
+	 * \return          How far \a entity moved, and what stopped it if any.
 	 */
-	virtual void
-	moveDown(Entity& entity, const int speed)
-	const noexcept = 0;
-};
+	World::SweepResult
+	followIntent(Entity& entity, const MovementIntent intent)
+	const noexcept;
 
-/**
- * \brief
- * Allows an entity to move.
- */
-class Movable : public Movement
-{
-public:
 	/**
 	 * \brief           Moves a game entity left.
 	 * 
 	 * \param entity    Game entity to move.
 	 * \param speed     Amoung of distance to move \a entity by.
+	 * \return          How far \a entity moved, and what stopped it if any.
 	 */
-	virtual void
+	World::SweepResult
 	moveLeft(Entity& entity, const int speed)
-	const noexcept override;
+	const noexcept;
 
 	/**
 	 * \brief           Moves a game entity up.
 	 * 
 	 * \param entity    Game entity to move.
 	 * \param speed     Amoung of distance to move \a entity by.
+	 * \return          How far \a entity moved, and what stopped it if any.
 	 */
-	virtual void
+	World::SweepResult
 	moveUp(Entity& entity, const int speed)
-	const noexcept override;
+	const noexcept;
 
 	/**
 	 * \brief           Moves a game entity right.
 	 * 
 	 * \param entity    Game entity to move.
 	 * \param speed     Amoung of distance to move \a entity by.
+	 * \return          How far \a entity moved, and what stopped it if any.
 	 */
-	virtual void
+	World::SweepResult
 	moveRight(Entity& entity, const int speed)
-	const noexcept override;
+	const noexcept;
 
 	/**
 	 * \brief           Moves a game entity down.
 	 * 
 	 * \param entity    Game entity to move.
 	 * \param speed     Amoung of distance to move \a entity by.
+	 * \return          How far \a entity moved, and what stopped it if any.
 	 */
-	virtual void
+	World::SweepResult
 	moveDown(Entity& entity, const int speed)
-	const noexcept override;
+	const noexcept;
+
+private:
+	/**
+	 * \brief                 Moves a game entity as far as the area map allows.
+	 * 
+	 * \param entity          Game entity to move.
+	 * \param displacement    Distance to move \a entity by, in pixels.
+	 * \return                How far \a entity moved, and what stopped it if any.
+	 */
+	World::SweepResult
+	move(Entity& entity, const type::Vector2 displacement)
+	const noexcept;
+
+	const World*  _world;  /// Area map to collide with, if any.
+	type::Vector2 _hitbox; /// Entity's hitbox dimensions.
 };
 
 /**
  * \brief
  * Prevents an entity from moving no matter the velocity.
  */
-class Immovable : public Movement
+class Immovable
 {
+public:
+	/// Movement phase skips entities with this handler.
+	static constexpr bool _can_move = false;
+
+	/**
+	 * \brief
+	 * Doesn't move the entity.
+	 * 
+	 * \return
+	 * Zero displacement.
+	 */
+	World::SweepResult
+	followIntent(
+		[[maybe_unused]] Entity&              entity,
+		[[maybe_unused]] const MovementIntent intent
+	) const noexcept;
+
 	/**
 	 * \brief
-	 * Doesn't do anything. Empty method.
+	 * Doesn't move the entity.
+	 * 
+	 * \return
+	 * Zero displacement.
 	 */
-	virtual void
+	World::SweepResult
 	moveLeft(
 		[[maybe_unused]] Entity&   entity,
 		[[maybe_unused]] const int speed
-	) const noexcept override;
+	) const noexcept;
 
 	/**
 	 * \brief
-	 * Doesn't do anything. Empty method.
+	 * Doesn't move the entity.
+	 * 
+	 * \return
+	 * Zero displacement.
 	 */
-	virtual void
+	World::SweepResult
 	moveUp(
 		[[maybe_unused]] Entity&   entity,
 		[[maybe_unused]] const int speed
-	) const noexcept override;
+	) const noexcept;
 
 	/**
 	 * \brief
-	 * Doesn't do anything. Empty method.
+	 * Doesn't move the entity.
+	 * 
+	 * \return
+	 * Zero displacement.
 	 */
-	virtual void
+	World::SweepResult
 	moveRight(
 		[[maybe_unused]] Entity&   entity,
 		[[maybe_unused]] const int speed
-	) const noexcept override;
+	) const noexcept;
 
 	/**
 	 * \brief
-	 * Doesn't do anything. Empty method.
+	 * Doesn't move the entity.
+	 * 
+	 * \return
+	 * Zero displacement.
 	 */
-	virtual void
+	World::SweepResult
 	moveDown(
 		[[maybe_unused]] Entity&   entity,
 		[[maybe_unused]] const int speed
-	) const noexcept override;
+	) const noexcept;
 };
 
+/**
+ * \brief
+ * Handles an entity's movements.
+ * 
+ * Handlers are plain values of one of a closed set of types rather than 
+ * implementations of a virtual interface. The functions below are defined 
+ * inline, so the visit compiles down to a branch on the handler's type with 
+ * the handler's method called directly. The registry keeps entities that can't
+ * move apart from those that can, so the movement phase never visits them.
+ */
+using Movement = std::variant< Movable, Immovable >;
+
+/**
+ * \brief             Moves a game entity the way its AI decided to.
+ * 
+ * \param movement    Entity's movement handler.
+ * \param entity      Game entity to move.
+ * \param intent      Direction and distance to move \a entity by.
+ * \return            How far \a entity moved, and what stopped it if any.
+ */
+inline World::SweepResult
+followIntent(
+	const Movement&      movement,
+	Entity&              entity, 
+	const MovementIntent intent
+) noexcept
+{
+	return std::visit(
+		[&entity, intent] (const auto& handler) {
+			return handler.followIntent(entity, intent);
+		}, 
+		movement
+	);
+}
+
+/**
+ * \brief             Indicate whether a movement handler ever moves entities.
+ * 
+ * \param movement    Movement handler.
+ * \return            True if yes, false if its entities can be skipped in the
+ *                    movement phase.
+ */
+inline bool
+canMove(const Movement& movement)
+noexcept
+{
+	return std::visit(
+		[] (const auto& handler) { return handler._can_move; }, movement
+	);
+}
+
 }
\ No newline at end of file
@@ -26,6 +26,11 @@ public:
 	
 	/**
 	 * \brief           Commits an entity to an action.
+	 * 
+	 * AIs are shared between entities and may be run for many entities at
+	 * once on different threads. They must only change their own entity, and
+	 * only through its intent.
+	 * 
 	 * \param entity    Entity.
 	 */
 	virtual void
@@ -6,7 +6,7 @@
 #pragma once
 
 #include "EntityAI.hpp"
-#include <random>
+#include "util/Random.hpp"
 
 namespace nemo::ai
 {
@@ -27,20 +27,13 @@ public:
 	override;
 
 private:
-	/**
-	 * \brief     Indicates whether to move or stand still.
-	 * \return    True for moving, false for standing still.
-	 */
-	bool
-	timeToMove()
-	const noexcept;
-
 	/**
 	 * \brief           Moves an entity to a random direction.
 	 * \param entity    Entity to move.
+	 * \param rng       Entity's random stream.
 	 */
 	void
-	goRandomDirection(Entity& entity)
+	goRandomDirection(Entity& entity, util::RandomStream& rng)
 	const noexcept;
 };
 
@@ -7,12 +7,15 @@
 
 #include "constants.hpp"
 
+#include <cstdint>
+#include <optional>
+
 namespace nemo::attr
 {
 
 /**
  * \brief
- * Speed at which an entity can move, in pixels per frame.
+ * Speed at which an entity can move, in pixels per simulation tick.
  */
 struct MovementSpeed
 {
@@ -20,4 +23,41 @@ struct MovementSpeed
 	int _running = constants::_running_speed; /// Running speed.
 };
 
+/**
+ * \brief
+ * Direction in which an entity can move.
+ */
+enum class Direction
+{
+	Left,  /// Towards x = 0.
+	Up,    /// Towards y = 0.
+	Right, /// Away from x = 0.
+	Down,  /// Away from y = 0.
+};
+
+/**
+ * \brief
+ * Movement that an entity's AI decided on for the current frame, to be carried
+ * out by the entity's movement handler in the movement phase.
+ */
+struct MovementIntent
+{
+	std::optional< Direction > _direction; /// Where to move, if anywhere.
+	int                        _speed = 0; /// Distance to move, in pixels.
+};
+
+/**
+ * \brief
+ * Odds of something happening on a simulation tick.
+ */
+struct Chance
+{
+	std::uint32_t _numerator;   /// Odds of happening.
+	std::uint32_t _denominator; /// Odds in total.
+};
+
+/// Chance that a wandering entity sets off walking on a tick. It stands still 
+/// roughly 80% of the time and walks the other 20%.
+constexpr Chance _wander_chance = { 2, 10 };
+
 }
\ No newline at end of file
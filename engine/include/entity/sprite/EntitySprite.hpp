@@ -5,7 +5,9 @@
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 
-#include <SFML/Graphics/RenderWindow.hpp>
+#include "RenderQueue.hpp"
+
+#include <memory>
 
 namespace nemo {
 	class Entity; // Forward declaration.
@@ -21,11 +23,22 @@ public:
 	~EntitySprite() = default;
 
 	/**
-	 * \brief
+	 * \brief           Queues the drawing of an entity for the current frame.
+	 * 
+	 * Nothing is drawn until \a queue is submitted.
+	 * 
+	 * \param queue     Render commands of the frame.
+	 * \param entity    Entity to draw.
+	 * \param alpha     How far the game is between the last simulation tick 
+	 *                  and the next one, from 0 to 1. Used to interpolate the
+	 *                  entity's position between ticks.
 	 */
 	virtual void
-	displayEntity(sf::RenderWindow& window, const Entity& entity)
-	const = 0;
+	queueEntity(
+		RenderQueue&      queue, 
+		const Entity&     entity, 
+		const float       alpha
+	) const = 0;
 };
 
 using entity_sprite_uptr_t = std::unique_ptr< EntitySprite >;
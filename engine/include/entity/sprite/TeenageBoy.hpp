@@ -17,8 +17,11 @@ class TeenageBoy : public EntitySprite
 {
 public:
 	virtual void
-	displayEntity(sf::RenderWindow& window, const Entity& entity)
-	const override;
+	queueEntity(
+		RenderQueue&      queue, 
+		const Entity&     entity, 
+		const float       alpha
+	) const override;
 };
 
 }
\ No newline at end of file
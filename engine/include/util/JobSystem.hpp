@@ -0,0 +1,191 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \copyright MIT License                                                   ///
+/// \author    Caylen Lee                                                    ///
+/// \date      2019                                                          ///
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace nemo::util
+{
+
+/**
+ * \brief
+ * Pool of worker threads that split loops between them.
+ *
+ * A loop is cut into chunks that are dealt out evenly to every worker's queue.
+ * Each worker runs the chunks in its own queue first, then steals from the
+ * back of the others' queues, so workers that finish early help the ones that
+ * got slower chunks instead of sitting idle.
+ *
+ * The thread running the loop works on it too, as worker 0.
+ *
+ * Usage example:
+ * \code
+ * 	nemo::util::JobSystem jobs;
+ *
+ * 	jobs.parallelFor(entities.size(), 256,
+ * 		[&] (const std::size_t begin, const std::size_t end) {
+ * 			for (std::size_t i = begin; i < end; ++i) {
+ * 				update(entities[i]);
+ * 			}
+ * 		}
+ * 	);
+ * \endcode
+ */
+class JobSystem
+{
+public:
+	/// Loop body, called with a range of iterations [begin, end).
+	using body_t = std::function< void(std::size_t, std::size_t) >;
+
+	/**
+	 * \brief
+	 * Starts the worker threads.
+	 *
+	 * \param num_workers
+	 * Number of workers, including the calling thread. Defaults to one per
+	 * core. With one worker, loops run on the calling thread only.
+	 */
+	explicit JobSystem(
+		const unsigned num_workers = std::thread::hardware_concurrency()
+	);
+
+	/**
+	 * \brief
+	 * Stops the worker threads.
+	 */
+	~JobSystem();
+
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator = (const JobSystem&) = delete;
+
+	/**
+	 * \brief
+	 * Gets the number of workers, including the calling thread.
+	 *
+	 * \return
+	 * Number of workers.
+	 */
+	unsigned
+	numWorkers()
+	const noexcept;
+
+	/**
+	 * \brief
+	 * Runs a loop across all the workers and waits for it to finish.
+	 *
+	 * Iterations may run in any order and at the same time as each other, so
+	 * the body must not write to anything another iteration reads or writes.
+	 * It must not throw.
+	 *
+	 * \param count    Number of iterations.
+	 * \param grain    Most iterations to run per chunk. Smaller chunks
+	 *                 balance better, larger ones cost less to hand out.
+	 * \param body     Loop body.
+	 */
+	void
+	parallelFor(
+		const std::size_t count,
+		const std::size_t grain,
+		const body_t&     body
+	);
+
+private:
+	/**
+	 * \brief
+	 * Range of iterations run in one go.
+	 */
+	struct Chunk
+	{
+		std::size_t _begin; /// First iteration.
+		std::size_t _end;   /// One past the last iteration.
+	};
+
+	/**
+	 * \brief
+	 * Chunks dealt out to one worker.
+	 */
+	struct Queue
+	{
+		std::mutex          _mutex;  /// Guards the chunks.
+		std::deque< Chunk > _chunks; /// Chunks not run yet.
+	};
+
+	/**
+	 * \brief
+	 * Main loop of a worker thread.
+	 *
+	 * \param worker
+	 * Worker index, from 1.
+	 */
+	void
+	work(const unsigned worker);
+
+	/**
+	 * \brief
+	 * Runs chunks of the current loop until there are none left to run or
+	 * steal.
+	 *
+	 * \param worker
+	 * Worker index.
+	 */
+	void
+	runChunks(const unsigned worker);
+
+	/**
+	 * \brief
+	 * Takes the next chunk from a worker's queue, or steals one from another
+	 * worker's queue if it's empty.
+	 *
+	 * \param worker
+	 * Worker index.
+	 *
+	 * \return
+	 * Chunk, or nothing if every queue is empty.
+	 */
+	std::optional< Chunk >
+	nextChunk(const unsigned worker);
+
+	/// Chunk queue of each worker.
+	std::unique_ptr< Queue[] >   _queues;
+
+	/// Number of workers, including the calling thread.
+	unsigned                     _num_workers;
+
+	/// Worker threads, i.e. every worker but the calling thread.
+	std::vector< std::thread >   _threads;
+
+	/// Body of the current loop.
+	const body_t*                _body;
+
+	/// Chunks of the current loop not finished yet.
+	std::atomic< std::size_t >   _num_remaining;
+
+	/// Number of loops started, so workers can tell a new one has started.
+	std::size_t                  _generation;
+
+	/// Whether the workers are to stop.
+	bool                         _is_stopping;
+
+	/// Guards the loop's body, generation and stop flag.
+	std::mutex                   _mutex;
+
+	/// Wakes the workers when a loop starts or they're to stop.
+	std::condition_variable      _wake;
+
+	/// Wakes the calling thread when a loop finishes.
+	std::condition_variable      _done;
+};
+
+}
@@ -0,0 +1,258 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \copyright MIT License                                                   ///
+/// \author    Caylen Lee                                                    ///
+/// \date      2019                                                          ///
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace nemo::util
+{
+
+/**
+ * \brief
+ * Stream of random numbers from a counter-based generator.
+ *
+ * The n-th number of a stream is a hash of the stream's key and n, so it
+ * doesn't depend on any number drawn before it. A stream has no state but its
+ * counter, which makes it free to create, copy and skip ahead, and lets many
+ * streams be drawn from in parallel without sharing anything.
+ */
+class RandomStream
+{
+public:
+	/**
+	 * \brief
+	 * Gets the n-th number of a stream without creating one.
+	 *
+	 * \param key        Stream's key.
+	 * \param counter    Position in the stream.
+	 *
+	 * \return
+	 * Random number.
+	 */
+	static constexpr std::uint64_t
+	at(const std::uint64_t key, const std::uint64_t counter)
+	noexcept
+	{
+		// SplitMix64's output function over a Weyl sequence.
+		std::uint64_t z = key + (counter + 1) * 0x9E3779B97F4A7C15u;
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9u;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBu;
+		return z ^ (z >> 31);
+	}
+
+	/**
+	 * \brief
+	 * Maps a random number to [0, bound).
+	 *
+	 * Uses a multiply and shift instead of a division. The result is biased by
+	 * at most bound / 2^32, which is negligible for gameplay.
+	 *
+	 * \param value    Random number.
+	 * \param bound    Upper bound, excluded.
+	 *
+	 * \return
+	 * Number less than \a bound.
+	 */
+	static constexpr std::uint32_t
+	below(const std::uint64_t value, const std::uint32_t bound)
+	noexcept
+	{
+		return static_cast< std::uint32_t >(((value >> 32) * bound) >> 32);
+	}
+
+	/**
+	 * \brief
+	 * Creates a stream.
+	 *
+	 * \param key        Stream's key.
+	 * \param counter    Position in the stream to start drawing from.
+	 */
+	RandomStream(const std::uint64_t key, const std::uint64_t counter = 0)
+	noexcept;
+
+	/**
+	 * \brief
+	 * Draws the next number.
+	 *
+	 * \return
+	 * Random number.
+	 */
+	std::uint64_t
+	next()
+	noexcept;
+
+	/**
+	 * \brief
+	 * Draws the next number in [0, bound).
+	 *
+	 * \param bound
+	 * Upper bound, excluded. Must be more than 0.
+	 *
+	 * \return
+	 * Random number less than \a bound.
+	 */
+	std::uint32_t
+	nextBelow(const std::uint32_t bound)
+	noexcept;
+
+	/**
+	 * \brief
+	 * Draws whether something with a chance of \a numerator in
+	 * \a denominator happens.
+	 *
+	 * \param numerator      Odds of happening.
+	 * \param denominator    Odds in total. Must be more than 0.
+	 *
+	 * \return
+	 * True if it happens, false otherwise.
+	 */
+	bool
+	nextChance(const std::uint32_t numerator, const std::uint32_t denominator)
+	noexcept;
+
+	/**
+	 * \brief
+	 * Skips numbers in the stream without drawing them.
+	 *
+	 * \param n
+	 * Number of numbers to skip.
+	 */
+	void
+	skip(const std::uint64_t n)
+	noexcept;
+
+	/**
+	 * \brief
+	 * Gets the position of the next number in the stream.
+	 *
+	 * \return
+	 * Counter.
+	 */
+	std::uint64_t
+	counter()
+	const noexcept;
+
+private:
+	std::uint64_t _key;     /// Stream's key.
+	std::uint64_t _counter; /// Position of the next number.
+};
+
+/**
+ * \brief
+ * Seedable source of independent random streams.
+ *
+ * Every stream is identified by a number, e.g. an entity's, and derived from
+ * the seed, so the same seed always gives the same numbers in the same streams
+ * regardless of how many threads draw from them or in which order.
+ *
+ * Usage example:
+ * \code
+ * 	nemo::util::Random random(seed);
+ *
+ * 	// Which of these entities move this tick, 2 in 10 chance each.
+ * 	random.chances(entity_ids, num_entities, tick, 2, 10, moves);
+ *
+ * 	// Same draw as moves[i].
+ * 	random.stream(entity_ids[i], tick).nextChance(2, 10);
+ * \endcode
+ */
+class Random
+{
+public:
+	/**
+	 * \brief
+	 * Creates a random number source.
+	 *
+	 * \param seed
+	 * Seed of all the streams.
+	 */
+	explicit Random(const std::uint64_t seed = 0)
+	noexcept;
+
+	/**
+	 * \brief
+	 * Changes the seed of all the streams.
+	 *
+	 * \param seed
+	 * New seed.
+	 */
+	void
+	reseed(const std::uint64_t seed)
+	noexcept;
+
+	/**
+	 * \brief
+	 * Gets the seed of all the streams.
+	 *
+	 * \return
+	 * Seed.
+	 */
+	std::uint64_t
+	seed()
+	const noexcept;
+
+	/**
+	 * \brief
+	 * Gets a stream.
+	 *
+	 * \param id         Stream's identifier.
+	 * \param counter    Position in the stream to start drawing from.
+	 *
+	 * \return
+	 * Stream.
+	 */
+	RandomStream
+	stream(const std::uint64_t id, const std::uint64_t counter = 0)
+	const noexcept;
+
+	/**
+	 * \brief
+	 * Draws whether something with a chance of \a numerator in
+	 * \a denominator happens, once for each of many streams.
+	 *
+	 * Every draw is the first number from \a counter in its stream, so it's
+	 * the same as drawing from each stream one by one. The loop has no
+	 * branches and no dependencies between streams, so it vectorizes.
+	 *
+	 * \param ids            Streams' identifiers.
+	 * \param n              Number of streams.
+	 * \param counter        Position in the streams to draw from.
+	 * \param numerator      Odds of happening.
+	 * \param denominator    Odds in total. Must be more than 0.
+	 * \param results        Receives 1 for each stream where it happens, 0
+	 *                       otherwise.
+	 */
+	void
+	chances(
+		const std::uint64_t* ids,
+		const std::size_t    n,
+		const std::uint64_t  counter,
+		const std::uint32_t  numerator,
+		const std::uint32_t  denominator,
+		std::uint8_t*        results
+	) const noexcept;
+
+private:
+	/**
+	 * \brief
+	 * Gets the key of a stream.
+	 *
+	 * \param id
+	 * Stream's identifier.
+	 *
+	 * \return
+	 * Key.
+	 */
+	std::uint64_t
+	key(const std::uint64_t id)
+	const noexcept;
+
+	/// Seed of all the streams.
+	std::uint64_t _seed;
+};
+
+}
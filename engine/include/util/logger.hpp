@@ -5,6 +5,22 @@
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 
+/**
+ * \brief
+ * Lowest level of log messages compiled in, one of spdlog's SPDLOG_LEVEL_*. 
+ * Calls to log below it compile to nothing, arguments included.
+ * 
+ * Defaults to info in release builds, i.e. with NDEBUG, so trace and debug 
+ * messages from hot paths cost nothing there, and to trace otherwise.
+ */
+#ifndef NEMO_LOG_LEVEL
+	#ifdef NDEBUG
+		#define NEMO_LOG_LEVEL SPDLOG_LEVEL_INFO
+	#else
+		#define NEMO_LOG_LEVEL SPDLOG_LEVEL_TRACE
+	#endif
+#endif
+
 /**
  * \brief
  * Compile-time log configurations.
@@ -13,11 +29,13 @@
  * These must be defined before including the spdlog library.
  */
 #define SPDLOG_TRACE_ON /// Includes source file and line number in messages.
-#define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_TRACE /// Log level threshold.
+#define SPDLOG_ACTIVE_LEVEL NEMO_LOG_LEVEL /// Log level threshold.
 
 #include <spdlog/spdlog.h>
 #include <spdlog/fmt/ostr.h>
 
+#include <chrono>
+#include <cstddef>
 #include <memory>
 #include <ostream>
 #include <filesystem>
@@ -25,6 +43,61 @@
 namespace nemo::util
 {
 
+/**
+ * \brief
+ * What to do with a message logged while the async queue is full.
+ */
+enum class LogOverflow
+{
+	Block,     /// Wait for room in the queue.
+	DropOldest /// Drop the oldest message in the queue to make room.
+};
+
+/**
+ * \brief
+ * Run-time log configurations.
+ */
+struct LoggerConfig
+{
+	/// Whether messages are written by a background thread instead of the 
+	/// thread logging them.
+	bool                 _is_async = true;
+
+	/// Most messages waiting to be written in async mode.
+	std::size_t          _queue_size = 8192;
+
+	/// What to do when the queue is full in async mode. Dropping messages 
+	/// never stalls the logging thread, but may lose warnings and errors.
+	LogOverflow          _overflow = LogOverflow::Block;
+
+	/// How often messages are flushed to the log file. Errors are flushed 
+	/// right away.
+	std::chrono::seconds _flush_interval = std::chrono::seconds(1);
+};
+
+/**
+ * \brief
+ * Configure the global logger before it's created.
+ * 
+ * Has no effect once the logger has been used. If it's never called, the 
+ * defaults of \link LoggerConfig are used.
+ * 
+ * \param config
+ * Logger configurations.
+ */
+void
+configureLogger(const LoggerConfig& config);
+
+/**
+ * \brief
+ * Writes out every queued message and stops the logger's background threads.
+ * 
+ * Call it before returning from main, so messages aren't lost when statics 
+ * are destroyed. Nothing is logged after it.
+ */
+void
+shutdownLogger();
+
 /**
  * \brief
  * Get an instance to the global logger singleton.
@@ -36,7 +109,7 @@ namespace nemo::util
  * \return
  * Instance to global logger singleton.
  */
-std::shared_ptr< spdlog::logger >
+const std::shared_ptr< spdlog::logger >&
 logger();
 
 }
@@ -5,7 +5,16 @@
 ////////////////////////////////////////////////////////////////////////////////
 #include "Camera.hpp"
 #include "World/World.hpp"
+#include "World/TilemapRenderer.hpp"
 #include "entity/Entity.hpp"
+#include "entity/EntityRegistry.hpp"
+#include "constants.hpp"
+
+#include <SFML/Graphics/View.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
 
 namespace nemo
 {
@@ -13,6 +22,16 @@ namespace nemo
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+namespace
+{
+	/// Extra distance around the camera view to still draw, in pixels. This 
+	/// keeps entities and tiles partially inside the view from popping in.
+	constexpr auto cull_margin_ = 2 * constants::_tile_side_length;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 Camera::Camera(const type::Vector2 size)
 	: _size(size)
 {
@@ -21,6 +40,11 @@ Camera::Camera(const type::Vector2 size)
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+Camera::~Camera() = default;
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 void
 Camera::setCenter(const Entity& entity)
 noexcept
@@ -43,12 +67,86 @@ noexcept
 
 void
 Camera::drawView(
-	sf::RenderWindow&            window, 
-	const World&                 world,
-	const std::vector< Entity >& entities
-) const
+	sf::RenderWindow& window, 
+	const World&      world,
+	EntityRegistry&   entities,
+	const float       alpha
+)
 {
+	if (!_tilemap || &_tilemap->world() != &world) {
+		// Bake the new area map from scratch.
+		_tilemap = std::make_unique< TilemapRenderer >(world);
+	}
+	else {
+		_tilemap->update();
+	}
+
+	window.setView(sf::View(
+		_position.sfVector2< float >(), _size.sfVector2< float >()
+	));
+
+	const auto [top_left, num_tiles] = visibleTiles(world);
+	_tilemap->draw(window, top_left, num_tiles);
+
+	for (std::size_t i = 0; i < entities.size(); ++i) {
+		const Entity entity = entities.at(i);
+
+		if (isVisible(entity)) {
+			entity.render(_entity_queue, alpha);
+		}
+	}
+
+	_entity_queue.submit(window);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+std::pair< type::RowColumnIndex, type::RowColumnIndex >
+Camera::visibleTiles(const World& world)
+const noexcept
+{
+	constexpr auto length = constants::_tile_side_length;
+	const type::RowColumnIndex world_size = world.size();
 	
+	// Pixel bounds of the camera view, including the margin.
+	const int x = type_safe::get(_position._x);
+	const int y = type_safe::get(_position._y);
+	const int half_w = type_safe::get(_size._x) / 2 + cull_margin_;
+	const int half_h = type_safe::get(_size._y) / 2 + cull_margin_;
+
+	// Convert to a range of tiles and clamp it to the area map.
+	const auto to_tile = [] (const int pixel, const unsigned num_tiles) {
+		const int tile = pixel < 0 ? 0 : (pixel + length - 1) / length;
+		return std::min(static_cast< unsigned >(tile), num_tiles);
+	};
+
+	const unsigned first_row = to_tile(y - half_h - length + 1, world_size._r);
+	const unsigned first_col = to_tile(x - half_w - length + 1, world_size._c);
+	const unsigned end_row = to_tile(y + half_h, world_size._r);
+	const unsigned end_col = to_tile(x + half_w, world_size._c);
+
+	return {
+		{ type::row_t(first_row), type::column_t(first_col) },
+		{ type::row_t(end_row - first_row), type::column_t(end_col - first_col) }
+	};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+bool
+Camera::isVisible(const Entity& entity)
+const noexcept
+{
+	const type::Vector2 offset = entity.position() - _position;
+	const int half_w = type_safe::get(_size._x) / 2 + cull_margin_;
+	const int half_h = type_safe::get(_size._y) / 2 + cull_margin_;
+
+	// An entity's position is its top-left corner, and the margin is wider than
+	// an entity, so this also catches entities hanging over the view's edges.
+	return std::abs(type_safe::get(offset._x)) <= half_w && 
+		std::abs(type_safe::get(offset._y)) <= half_h;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -10,7 +10,6 @@
 
 #include <nlohmann/json.hpp>
 #include <magic_enum.hpp>
-#include <boost/assign/list_of.hpp>
 
 #include <fstream>
 #include <string>
@@ -28,19 +27,57 @@ namespace
 	// Default path to a directory of keyboard mapping files.
 	const std::filesystem::path controller_dir_ = constants::_asset_dir / 
 		"controller";
+
+	static_assert(
+		Controller::_num_buttons == magic_enum::enum_count< Button >(),
+		"Controller::_num_buttons doesn't match the number of buttons"
+	);
+
+	/// Directional controls.
+	constexpr auto direction_buttons_ = Controller::mask({ 
+		Button::Left, Button::Up, Button::Right, Button::Down
+	});
+
+	/// Selection controls.
+	constexpr auto selection_buttons_ = Controller::mask({ 
+		Button::Cancel, Button::Select, Button::Pause
+	});
+
+	/**
+	 * \brief        Checks whether a key has a slot in the key tables.
+	 * \param key    Keyboard key.
+	 * \return       True if yes, false for unknown keys.
+	 */
+	constexpr bool
+	is_known_key_(const Controller::key_t key)
+	noexcept
+	{
+		return key >= 0 && key < Controller::key_t::KeyCount;
+	}
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
-std::deque< Controller::key_t >
+std::array< bool, Controller::_num_keys >
+Controller::_is_key_pressed = {};
+
+Controller::pressed_keys_t
 Controller::_pressed_keys = {};
 
+std::size_t
+Controller::_newest_key = 0;
+
+std::size_t
+Controller::_num_pressed_keys = 0;
+
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
 Controller::Controller()
 {
+	_key_to_button.fill(std::nullopt);
+	_button_to_key.fill(key_t::Unknown);
 	useDefaultKeyMappings();
 }
 
@@ -50,6 +87,9 @@ Controller::Controller()
 Controller::Controller(const std::filesystem::path& file)
 	: _config_file(file)
 {
+	_key_to_button.fill(std::nullopt);
+	_button_to_key.fill(key_t::Unknown);
+
 	const std::optional< nlohmann::json > 
 		config = util::readJsonFile(_config_file);
 
@@ -136,16 +176,24 @@ Controller::useDefaultKeyMappings()
 void
 Controller::registerKeyPress(const key_t key)
 {
-	if (std::any_of(
-		_pressed_keys.cbegin(), _pressed_keys.cend(), 
-		[key] (const key_t p) { return p == key; }
-	)) {
+	if (!is_known_key_(key) || _is_key_pressed[key]) {
 		// Avoid adding a key already being pressed to the list of pressed keys.
 		return;
 	}
 
-	// Newly pressed key.
-	_pressed_keys.push_front(key);
+	// Newly pressed key goes in front of the ring.
+	_newest_key = (_newest_key + _max_pressed_keys - 1) % _max_pressed_keys;
+
+	if (_num_pressed_keys == _max_pressed_keys) {
+		// Ring is full, so the new key overwrites the oldest one.
+		_is_key_pressed[_pressed_keys[_newest_key]] = false;
+	}
+	else {
+		++_num_pressed_keys;
+	}
+
+	_pressed_keys[_newest_key] = key;
+	_is_key_pressed[key] = true;
 	NEMO_DEBUG("Key {} pressed", key);
 }
 
@@ -155,28 +203,94 @@ Controller::registerKeyPress(const key_t key)
 void
 Controller::registerKeyRelease(const key_t key)
 {
-	// Remove key from the list of pressed keys.
-	const auto keys_to_remove = std::remove(
-		_pressed_keys.begin(), _pressed_keys.end(), key
-	);
+	if (!is_known_key_(key) || !_is_key_pressed[key]) {
+		return;
+	}
 
-	_pressed_keys.erase(keys_to_remove, _pressed_keys.end());
+	_is_key_pressed[key] = false;
+
+	// Remove key from the ring by shifting the older keys after it forward.
+	std::size_t i = 0;
+
+	while (_pressed_keys[(_newest_key + i) % _max_pressed_keys] != key) {
+		++i;
+	}
+
+	for (; i + 1 < _num_pressed_keys; ++i) {
+		_pressed_keys[(_newest_key + i) % _max_pressed_keys] = 
+			_pressed_keys[(_newest_key + i + 1) % _max_pressed_keys];
+	}
+
+	--_num_pressed_keys;
 	NEMO_DEBUG("Key {} released", key);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+std::size_t
+Controller::pressedKeys(pressed_keys_t& keys)
+noexcept
+{
+	for (std::size_t i = 0; i < _num_pressed_keys; ++i) {
+		keys[i] = _pressed_keys[(_newest_key + i) % _max_pressed_keys];
+	}
+
+	return _num_pressed_keys;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+Controller::setPressedKeys(const pressed_keys_t& keys, const std::size_t count)
+noexcept
+{
+	_is_key_pressed.fill(false);
+	_newest_key = 0;
+	_num_pressed_keys = 0;
+
+	for (std::size_t i = 0; i < std::min(count, _max_pressed_keys); ++i) {
+		if (!is_known_key_(keys[i]) || _is_key_pressed[keys[i]]) {
+			continue;
+		}
+
+		_pressed_keys[_num_pressed_keys++] = keys[i];
+		_is_key_pressed[keys[i]] = true;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+Controller::registerKeyEvents(const std::vector< InputEvent >& events)
+{
+	for (const InputEvent& e : events) {
+		switch (e._event.type) {
+			case sf::Event::KeyPressed:
+			registerKeyPress(e._event.key.code);
+			break;
+
+			case sf::Event::KeyReleased:
+			registerKeyRelease(e._event.key.code);
+			break;
+
+			default:
+			break;
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 std::optional< Button >
 Controller::pressedDirection()
-const
+const noexcept
 {
-	const static std::vector< Button > limit_buttons_to = { 
-		Button::Left, Button::Up, Button::Right, Button::Down
-	};
-
 	// Limit the query to directional buttons only.
-	return pressedButton(limit_buttons_to);
+	return pressedButton(direction_buttons_);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -184,50 +298,33 @@ const
 
 std::optional< Button >
 Controller::pressedSelection()
-const
+const noexcept
 {
-	const static std::vector< Button > limit_buttons_to = { 
-		Button::Cancel, Button::Select, Button::Pause
-	};
-
 	// Limit the query to selection buttons only.
-	return pressedButton(limit_buttons_to);
+	return pressedButton(selection_buttons_);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
 std::optional< Button >
-Controller::pressedButton(const std::vector< Button > button_filters)
-const
+Controller::pressedButton(const button_mask_t button_filters)
+const noexcept
 {
 	// Prioritize more recently pressed keys. If the up button is pressed while 
 	// the left button is still pressed, for example, the up button will be used 
 	// instead of the left button as long as both buttons are held (assuming 
 	// we're looking for any directional input).
-	for (const key_t k : _pressed_keys) {
-		const auto key_to_button = _key_mappings.left.find(k);
-		
-		if (key_to_button == _key_mappings.left.end()) {
-			// This pressed key isn't mapped to any control.
-			continue;
-		}
-
-		const Button button = key_to_button->second;
+	for (std::size_t i = 0; i < _num_pressed_keys; ++i) {
+		const key_t k = _pressed_keys[(_newest_key + i) % _max_pressed_keys];
+		const std::optional< Button > button = _key_to_button[k];
 		
-		if (!button_filters.empty() && // button search filter is supplied
-			std::none_of(
-				button_filters.cbegin(), button_filters.cend(), 
-				[button] (const Button allowed) { return allowed == button; }
-			)) 
-		{
-			// The controller button mapped to this pressed key isn't one of the
-			// buttons we are looking for.
-			continue;
+		if (button && (button_filters & mask({ *button }))) {
+			return button;
 		}
 
-		NEMO_DEBUG("Found [{}] being pressed", magic_enum::enum_name(button));
-		return button;
+		// Otherwise, this pressed key isn't mapped to any control, or the 
+		// control isn't one of the buttons we are looking for.
 	}
 
 	return {};
@@ -236,16 +333,40 @@ const
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+std::optional< Button >
+Controller::pressedButton(const std::initializer_list< Button > button_filters)
+const noexcept
+{
+	return pressedButton(mask(button_filters));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 void
 Controller::changeKeyMapping(const key_t key, const Button button)
 {
+	if (!is_known_key_(key)) {
+		NEMO_WARN("Cannot map [{}] to unknown key {}", 
+			magic_enum::enum_name(button), key);
+		return;
+	}
+
+	const auto b = static_cast< std::size_t >(button);
+
 	// Delete whatever the control and key were previously mapped to. A key 
 	// cannot be mapped to multiple controls, and vice versa.
-	_key_mappings.left.erase(key);
-	_key_mappings.right.erase(button);
+	if (const std::optional< Button > old_button = _key_to_button[key]) {
+		_button_to_key[static_cast< std::size_t >(*old_button)] = key_t::Unknown;
+	}
+
+	if (const key_t old_key = _button_to_key[b]; is_known_key_(old_key)) {
+		_key_to_button[old_key] = std::nullopt;
+	}
 
 	// Add new mapping.
-	_key_mappings.push_back({ key, button });
+	_key_to_button[key] = button;
+	_button_to_key[b] = key;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -266,10 +387,17 @@ const
 
 	nlohmann::json config;
 
-	for (const auto& [key, button] : _key_mappings.right) {
+	for (std::size_t b = 0; b < _num_buttons; ++b) {
+		if (!is_known_key_(_button_to_key[b])) {
+			// Unmapped control.
+			continue;
+		}
+
 		// Use the controller input's name as the json property's key.
-		const auto button_field = std::string(magic_enum::enum_name(button));
-		config[button_field] = key;
+		const auto button_field = std::string(
+			magic_enum::enum_name(static_cast< Button >(b))
+		);
+		config[button_field] = _button_to_key[b];
 	}
 
 	// Dump json to file, using a 4-space indentation.
@@ -292,8 +420,10 @@ Controller::isValidController()
 const noexcept
 {
 	// With 1:1 bidrectional mapping being enforced, the controller is valid if 
-	// we have the same number of mappings as the number of possible buttons.
-	return _key_mappings.size() == magic_enum::enum_count< Button >();
+	// every button is mapped to a key.
+	return std::all_of(
+		_button_to_key.cbegin(), _button_to_key.cend(), is_known_key_
+	);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
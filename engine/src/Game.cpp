@@ -6,6 +6,9 @@
 #include "Game.hpp"
 #include "entity/EntityMake.hpp"
 #include "util/logger.hpp"
+#include "constants.hpp"
+
+#include <algorithm>
 
 namespace nemo
 {
@@ -13,11 +16,43 @@ namespace nemo
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+namespace
+{
+	/// Most ticks to run in one frame to catch up with real time.
+	constexpr auto max_ticks_per_frame_ = 5;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 Game::Game()
 	: _is_playing(true)
-	, _player(EntityMake::entity(EntityID::Hero))
-	, _npc(EntityMake::entity(EntityID::TeenageBoy))
+	, _camera(type::Vector2(
+		type::x_t(constants::_window_width), 
+		type::y_t(constants::_window_height)
+	))
+	, _player()
+	, _phase_times()
+	, _tick_length(0)
+	, _accumulator(0)
+	, _recorder(nullptr)
 {
+	setTickRate(constants::_tick_rate);
+
+	// Every entity spawned from now on collides with the area map.
+	_entities.setWorld(&_world);
+
+	constexpr auto length = constants::_tile_side_length;
+
+	// Start on walkable tiles of the tutorial's top row, and keep the NPC from
+	// spawning on top of the player.
+	Entity player = EntityMake::hero(_entities);
+	player.teleport({ type::x_t(length), type::y_t(0) });
+	_player = player.handle();
+
+	EntityMake::teenageBoy(_entities).teleport({ 
+		type::x_t(4 * length), type::y_t(0)
+	});
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -56,14 +91,143 @@ noexcept
 ////////////////////////////////////////////////////////////////////////////////
 
 void
-Game::updateFrame(sf::RenderWindow& window)
+Game::setTickRate(const unsigned ticks_per_second)
+noexcept
+{
+	_tick_length = std::chrono::nanoseconds(std::chrono::seconds(1)) / 
+		std::max(ticks_per_second, 1u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+Game::setRecorder(InputRecorder* recorder)
+noexcept
+{
+	_recorder = recorder;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+Game::updateFrame(
+	sf::RenderWindow&              window, 
+	const std::chrono::nanoseconds elapsed
+)
 {
+	_phase_times = {};
+
 	if (!_is_playing) {
+		// Don't catch up on the time spent paused.
+		_accumulator = std::chrono::nanoseconds(0);
 		return;
 	}
 
-	_player->updateObject(window);
-	// _npc->updateObject(window);
+	// After a long stall, drop the time that can't be caught up on instead of 
+	// falling further behind trying to.
+	_accumulator = std::min(
+		_accumulator + elapsed, max_ticks_per_frame_ * _tick_length
+	);
+
+	while (_accumulator >= _tick_length) {
+		tick();
+		_accumulator -= _tick_length;
+	}
+
+	const float alpha = static_cast< float >(_accumulator.count()) / 
+		static_cast< float >(_tick_length.count());
+
+	render(window, alpha);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+Game::tick()
+{
+	using clock = std::chrono::steady_clock;
+	using std::chrono::duration_cast;
+	using std::chrono::microseconds;
+
+	if (_recorder) {
+		_recorder->recordTick();
+	}
+
+	const auto start = clock::now();
+	_entities.runAI(_jobs);
+
+	const auto ai_done = clock::now();
+	_entities.applyMovement();
+
+	const auto movement_done = clock::now();
+
+	_phase_times._ai += duration_cast< microseconds >(ai_done - start);
+	_phase_times._movement += 
+		duration_cast< microseconds >(movement_done - ai_done);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+Game::render(sf::RenderWindow& window, const float alpha)
+{
+	using clock = std::chrono::steady_clock;
+	using std::chrono::duration_cast;
+	using std::chrono::microseconds;
+
+	const auto start = clock::now();
+
+	if (_entities.contains(_player)) {
+		_camera.setCenter(_entities.entity(_player));
+	}
+
+	_camera.drawView(window, _world, _entities, alpha);
+
+	_phase_times._render = duration_cast< microseconds >(clock::now() - start);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+EntityRegistry&
+Game::entities()
+noexcept
+{
+	return _entities;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+const World&
+Game::world()
+const noexcept
+{
+	return _world;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+Game::releaseTextures()
+noexcept
+{
+	_world.releaseTileset();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+Game::PhaseTimes
+Game::lastPhaseTimes()
+const noexcept
+{
+	return _phase_times;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
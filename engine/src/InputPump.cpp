@@ -0,0 +1,30 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \copyright MIT License                                                   ///
+/// \author    Caylen Lee                                                    ///
+/// \date      2019                                                          ///
+////////////////////////////////////////////////////////////////////////////////
+#include "InputPump.hpp"
+
+namespace nemo
+{
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+const std::vector< InputEvent >&
+InputPump::drain(sf::Window& window)
+{
+	_events.clear();
+	sf::Event event;
+
+	while (window.pollEvent(event)) {
+		_events.push_back({ event, InputEvent::clock_t::now() });
+	}
+
+	return _events;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+}
@@ -0,0 +1,267 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \copyright MIT License                                                   ///
+/// \author    Caylen Lee                                                    ///
+/// \date      2019                                                          ///
+////////////////////////////////////////////////////////////////////////////////
+#include "InputRecording.hpp"
+#include "util/logger.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace nemo
+{
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+	/**
+	 * \brief
+	 * Beginning of a recording file.
+	 */
+	struct RecordingHeader
+	{
+		char          _magic[8];  /// Always \link recording_magic_.
+		std::uint32_t _version;   /// Always \link recording_version_.
+		std::uint32_t _tick_rate; /// Simulation ticks per second.
+		std::uint32_t _num_ticks; /// Number of ticks recorded.
+		std::uint32_t _reserved;  /// Always 0.
+		std::uint64_t _seed;      /// Seed of the entities' random numbers.
+	};
+
+	constexpr char          recording_magic_[8] = "NEMOREC";
+	constexpr std::uint32_t recording_version_  = 2;
+
+	static_assert(Controller::key_t::KeyCount <= 0xFF,
+		"Key codes must fit in a byte to be recorded");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+InputRecorder::InputRecorder(
+	const std::filesystem::path& file,
+	const unsigned               tick_rate,
+	const std::uint64_t          seed
+)
+	: _file(file, std::ios::binary)
+	, _num_ticks(0)
+	, _header_interval(std::max(tick_rate, 1u))
+	, _last_keys()
+	, _num_last_keys(0)
+{
+	RecordingHeader header = {};
+	std::memcpy(header._magic, recording_magic_, sizeof(header._magic));
+	header._version = recording_version_;
+	header._tick_rate = tick_rate;
+	header._seed = seed;
+
+	// The number of ticks is filled in as the recording goes.
+	_file.write(reinterpret_cast< const char* >(&header), sizeof(header));
+
+	if (!_file) {
+		NEMO_ERROR("Failed to start recording input to {}", file);
+		return;
+	}
+
+	NEMO_INFO("Recording input to {}", file);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+InputRecorder::~InputRecorder()
+{
+	if (!_file) {
+		return;
+	}
+
+	updateHeader();
+
+	if (!_file) {
+		NEMO_ERROR("Failed to finish recording input");
+		return;
+	}
+
+	NEMO_INFO("Recorded {} ticks of input", _num_ticks);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+InputRecorder::recordTick()
+{
+	Controller::pressed_keys_t keys;
+	const std::size_t num_keys = Controller::pressedKeys(keys);
+	const std::uint32_t tick = _num_ticks++;
+
+	// Keep the header current, so a crash doesn't lose the whole recording.
+	if (_num_ticks % _header_interval == 0) {
+		updateHeader();
+	}
+
+	if (num_keys == _num_last_keys &&
+		std::equal(keys.cbegin(), keys.cbegin() + num_keys, _last_keys.cbegin()))
+	{
+		// Same keys as the last tick.
+		return;
+	}
+
+	std::uint8_t record[sizeof(tick) + 1 + Controller::_max_pressed_keys];
+	std::memcpy(record, &tick, sizeof(tick));
+	record[sizeof(tick)] = static_cast< std::uint8_t >(num_keys);
+
+	for (std::size_t i = 0; i < num_keys; ++i) {
+		record[sizeof(tick) + 1 + i] = static_cast< std::uint8_t >(keys[i]);
+	}
+
+	_file.write(
+		reinterpret_cast< const char* >(record), sizeof(tick) + 1 + num_keys
+	);
+
+	_last_keys = keys;
+	_num_last_keys = num_keys;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+InputRecorder::updateHeader()
+{
+	const std::ofstream::pos_type end = _file.tellp();
+	_file.seekp(offsetof(RecordingHeader, _num_ticks));
+	_file.write(reinterpret_cast< const char* >(&_num_ticks), sizeof(_num_ticks));
+	_file.seekp(end);
+	_file.flush();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+bool
+InputRecorder::isRecording()
+const noexcept
+{
+	return static_cast< bool >(_file);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+InputReplay::InputReplay(const std::filesystem::path& file)
+	: _next_record(0)
+	, _tick(0)
+	, _num_ticks(0)
+	, _tick_rate(0)
+	, _seed(0)
+{
+	std::ifstream ifs(file, std::ios::binary);
+	RecordingHeader header = {};
+
+	if (!ifs.read(reinterpret_cast< char* >(&header), sizeof(header)) ||
+		std::memcmp(header._magic, recording_magic_, sizeof(header._magic)) ||
+		header._version != recording_version_)
+	{
+		NEMO_ERROR("{} is not an input recording", file);
+		return;
+	}
+
+	std::uint32_t tick;
+	std::uint8_t num_keys;
+
+	while (ifs.read(reinterpret_cast< char* >(&tick), sizeof(tick))) {
+		Record record = { tick, {}, 0 };
+		std::uint8_t keys[Controller::_max_pressed_keys];
+
+		if (!ifs.read(reinterpret_cast< char* >(&num_keys), sizeof(num_keys)) ||
+			num_keys > Controller::_max_pressed_keys ||
+			!ifs.read(reinterpret_cast< char* >(keys), num_keys))
+		{
+			// Keep the records before the cut.
+			NEMO_WARN("Truncated input recording {}", file);
+			break;
+		}
+
+		for (std::size_t i = 0; i < num_keys; ++i) {
+			record._keys[i] = static_cast< Controller::key_t >(keys[i]);
+		}
+
+		record._num_keys = num_keys;
+		_records.push_back(record);
+	}
+
+	// The header may not have been updated since the last records were 
+	// written, but every record's tick was played.
+	_num_ticks = _records.empty() 
+		? header._num_ticks 
+		: std::max(header._num_ticks, _records.back()._tick + 1);
+	_tick_rate = header._tick_rate;
+	_seed = header._seed;
+	NEMO_INFO("Loaded {} ticks of input from {}", _num_ticks, file);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+bool
+InputReplay::replayTick()
+noexcept
+{
+	if (_tick >= _num_ticks) {
+		return false;
+	}
+
+	if (_next_record < _records.size() &&
+		_records[_next_record]._tick == _tick)
+	{
+		// Pressed keys changed on this tick.
+		const Record& record = _records[_next_record++];
+		Controller::setPressedKeys(record._keys, record._num_keys);
+	}
+	else if (_tick == 0) {
+		// Recording started with no keys pressed.
+		Controller::setPressedKeys({}, 0);
+	}
+
+	++_tick;
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned
+InputReplay::tickRate()
+const noexcept
+{
+	return _tick_rate;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+std::uint32_t
+InputReplay::numTicks()
+const noexcept
+{
+	return _num_ticks;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+std::uint64_t
+InputReplay::seed()
+const noexcept
+{
+	return _seed;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+}
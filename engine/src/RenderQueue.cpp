@@ -0,0 +1,124 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \copyright MIT License                                                   ///
+/// \author    Caylen Lee                                                    ///
+/// \date      2019                                                          ///
+////////////////////////////////////////////////////////////////////////////////
+#include "RenderQueue.hpp"
+
+#include <SFML/Graphics/PrimitiveType.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+
+#include <algorithm>
+#include <functional>
+
+namespace nemo
+{
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+RenderQueue::push(const RenderCommand& command)
+{
+	_commands.push_back(command);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+std::size_t
+RenderQueue::size()
+const noexcept
+{
+	return _commands.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+RenderQueue::clear()
+noexcept
+{
+	_commands.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+std::size_t
+RenderQueue::submit(sf::RenderTarget& target)
+{
+	std::stable_sort(_commands.begin(), _commands.end(),
+		[] (const RenderCommand& lhs, const RenderCommand& rhs) {
+			if (lhs._depth != rhs._depth) {
+				return lhs._depth < rhs._depth;
+			}
+
+			return std::less< const sf::Texture* >()(
+				lhs._texture, rhs._texture
+			);
+		}
+	);
+
+	std::size_t num_draw_calls = 0;
+	auto batch_begin = _commands.cbegin();
+
+	while (batch_begin != _commands.cend()) {
+		// Commands up to the next change of texture go into the same batch.
+		const sf::Texture* texture = batch_begin->_texture;
+		const auto batch_end = std::find_if(batch_begin, _commands.cend(),
+			[texture] (const RenderCommand& command) {
+				return command._texture != texture;
+			}
+		);
+
+		_vertices.clear();
+
+		for (auto it = batch_begin; it != batch_end; ++it) {
+			const sf::FloatRect& b = it->_bounds;
+			const sf::IntRect& t = it->_texture_rect;
+			const auto left   = static_cast< float >(t.left);
+			const auto top    = static_cast< float >(t.top);
+			const auto right  = static_cast< float >(t.left + t.width);
+			const auto bottom = static_cast< float >(t.top + t.height);
+
+			_vertices.emplace_back(
+				sf::Vector2f(b.left, b.top),
+				it->_color,
+				sf::Vector2f(left, top)
+			);
+			_vertices.emplace_back(
+				sf::Vector2f(b.left + b.width, b.top),
+				it->_color,
+				sf::Vector2f(right, top)
+			);
+			_vertices.emplace_back(
+				sf::Vector2f(b.left + b.width, b.top + b.height),
+				it->_color,
+				sf::Vector2f(right, bottom)
+			);
+			_vertices.emplace_back(
+				sf::Vector2f(b.left, b.top + b.height),
+				it->_color,
+				sf::Vector2f(left, bottom)
+			);
+		}
+
+		target.draw(
+			_vertices.data(), _vertices.size(), sf::Quads,
+			sf::RenderStates(texture)
+		);
+
+		++num_draw_calls;
+		batch_begin = batch_end;
+	}
+
+	_commands.clear();
+	return num_draw_calls;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+}
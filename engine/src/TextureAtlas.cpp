@@ -0,0 +1,258 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \copyright MIT License                                                   ///
+/// \author    Caylen Lee                                                    ///
+/// \date      2019                                                          ///
+////////////////////////////////////////////////////////////////////////////////
+#include "TextureAtlas.hpp"
+#include "util/logger.hpp"
+
+#include <SFML/Graphics/Color.hpp>
+
+#include <algorithm>
+#include <numeric>
+
+namespace nemo
+{
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+	/// Transparent pixels left between sheets on a page.
+	constexpr unsigned gutter_ = 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+TextureAtlas::TextureAtlas(const unsigned page_size)
+	: _page_size(std::min(page_size, sf::Texture::getMaximumSize()))
+	, _is_packed(false)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+std::optional< TextureAtlas::sheet_t >
+TextureAtlas::addSheet(
+	const std::filesystem::path& file,
+	const int                    tile_side_length
+)
+{
+	sf::Image image;
+
+	if (!image.loadFromFile(file.string())) {
+		NEMO_ERROR("Failed to load sheet {} into atlas", file);
+		return {};
+	}
+
+	return addSheet(image, tile_side_length);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+std::optional< TextureAtlas::sheet_t >
+TextureAtlas::addSheet(const sf::Image& image, const int tile_side_length)
+{
+	if (_is_packed) {
+		NEMO_ERROR("Can't add a sheet to an atlas that was already packed");
+		return {};
+	}
+
+	const sf::Vector2u size = image.getSize();
+
+	if (size.x > _page_size || size.y > _page_size || tile_side_length <= 0) {
+		NEMO_ERROR(
+			"Sheet of {}x{} doesn't fit in atlas pages of {}x{}",
+			size.x, size.y, _page_size, _page_size
+		);
+		return {};
+	}
+
+	const auto length = static_cast< unsigned >(tile_side_length);
+	_sheets.push_back({
+		image, size, tile_side_length, size.y / length, size.x / length, 0, 0
+	});
+
+	return _sheets.size() - 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+bool
+TextureAtlas::pack()
+{
+	if (_is_packed) {
+		NEMO_ERROR("Atlas was already packed");
+		return false;
+	}
+
+	_is_packed = true;
+
+	if (_sheets.empty()) {
+		return true;
+	}
+
+	// Tallest first, so each shelf wastes as little height as possible.
+	std::vector< std::size_t > order(_sheets.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(),
+		[this] (const std::size_t lhs, const std::size_t rhs) {
+			return _sheets[lhs]._size.y > _sheets[rhs]._size.y;
+		}
+	);
+
+	// Top-left corner of each sheet on its page.
+	std::vector< sf::Vector2u > corners(_sheets.size());
+	std::vector< unsigned > page_heights = { 0 };
+	unsigned x = 0;
+	unsigned shelf_y = 0;
+	unsigned shelf_height = 0;
+
+	for (const std::size_t i : order) {
+		const sf::Vector2u size = _sheets[i]._size;
+
+		if (x + size.x > _page_size) {
+			// Start a new shelf below the current one.
+			shelf_y += shelf_height;
+			shelf_height = 0;
+			x = 0;
+		}
+
+		if (shelf_y + size.y > _page_size) {
+			// Start a new page.
+			page_heights.push_back(0);
+			shelf_y = 0;
+			shelf_height = 0;
+			x = 0;
+		}
+
+		_sheets[i]._page = page_heights.size() - 1;
+		corners[i] = { x, shelf_y };
+		page_heights.back() = std::max(page_heights.back(), shelf_y + size.y);
+
+		// Keep a gutter to the right of and below the sheet.
+		x += size.x + gutter_;
+		shelf_height = std::max(shelf_height, size.y + gutter_);
+	}
+
+	// Copy the sheets onto their pages. Pages are only as tall as they need to
+	// be, to save texture memory.
+	std::vector< sf::Image > images(page_heights.size());
+
+	for (std::size_t p = 0; p < images.size(); ++p) {
+		images[p].create(_page_size, page_heights[p], sf::Color::Transparent);
+	}
+
+	for (std::size_t i = 0; i < _sheets.size(); ++i) {
+		Sheet& sheet = _sheets[i];
+		images[sheet._page].copy(sheet._image, corners[i].x, corners[i].y);
+
+		// The pixels live on the pages from now on.
+		sheet._image = sf::Image();
+	}
+
+	bool is_uploaded = true;
+
+	for (const sf::Image& image : images) {
+		auto& texture = _pages.emplace_back(std::make_unique< sf::Texture >());
+
+		if (!texture->loadFromImage(image)) {
+			NEMO_ERROR("Failed to upload atlas page {}", _pages.size() - 1);
+			is_uploaded = false;
+		}
+	}
+
+	// Fill the lookup table, sheet by sheet, row by row.
+	for (std::size_t i = 0; i < _sheets.size(); ++i) {
+		Sheet& sheet = _sheets[i];
+		const int length = sheet._tile_side_length;
+		sheet._first_tile = _tile_rects.size();
+
+		for (unsigned r = 0; r < sheet._num_rows; ++r) {
+			for (unsigned c = 0; c < sheet._num_columns; ++c) {
+				_tile_rects.emplace_back(
+					static_cast< int >(corners[i].x + c * length),
+					static_cast< int >(corners[i].y + r * length),
+					length,
+					length
+				);
+			}
+		}
+	}
+
+	NEMO_INFO(
+		"Packed {} sheets into {} atlas pages", _sheets.size(), _pages.size()
+	);
+
+	return is_uploaded;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+std::size_t
+TextureAtlas::numPages()
+const noexcept
+{
+	return _pages.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+const sf::Texture&
+TextureAtlas::page(const std::size_t page)
+const noexcept
+{
+	return *_pages[page];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+std::size_t
+TextureAtlas::pageOf(const sheet_t sheet)
+const noexcept
+{
+	return _sheets[sheet]._page;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+type::RowColumnIndex
+TextureAtlas::sheetSize(const sheet_t sheet)
+const noexcept
+{
+	const Sheet& s = _sheets[sheet];
+	return { type::row_t(s._num_rows), type::column_t(s._num_columns) };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+AtlasRegion
+TextureAtlas::region(const sheet_t sheet, const type::RowColumnIndex index)
+const noexcept
+{
+	const Sheet& s = _sheets[sheet];
+
+	if (index._r >= s._num_rows || index._c >= s._num_columns) {
+		return { s._page, sf::IntRect() };
+	}
+
+	const std::size_t tile =
+		s._first_tile + std::size_t(index._r) * s._num_columns + index._c;
+
+	return { s._page, _tile_rects[tile] };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+}
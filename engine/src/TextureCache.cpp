@@ -0,0 +1,136 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \copyright MIT License                                                   ///
+/// \author    Caylen Lee                                                    ///
+/// \date      2019                                                          ///
+////////////////////////////////////////////////////////////////////////////////
+#include "TextureCache.hpp"
+#include "util/logger.hpp"
+
+namespace nemo
+{
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+TextureCache&
+TextureCache::getInstance()
+{
+	static TextureCache instance;
+	return instance;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+TextureCache::TextureCache(const std::size_t budget)
+	: _budget(budget)
+	, _stats()
+	, _num_loads(0)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+std::shared_ptr< const sf::Texture >
+TextureCache::load(const std::filesystem::path& file)
+{
+	const std::string key = file.lexically_normal().string();
+	std::lock_guard lock(_mutex);
+
+	if (const auto it = _entries.find(key); it != _entries.end()) {
+		++_stats._hits;
+		it->second._last_load = ++_num_loads;
+		return it->second._texture;
+	}
+
+	++_stats._misses;
+	auto texture = std::make_shared< sf::Texture >();
+
+	if (!texture->loadFromFile(key)) {
+		NEMO_ERROR("Failed to load texture from {}", file);
+		return nullptr;
+	}
+
+	// Textures are stored as 32-bit RGBA.
+	const sf::Vector2u size = texture->getSize();
+	const std::size_t bytes = std::size_t(size.x) * size.y * 4;
+
+	_entries.emplace(key, Entry{ texture, bytes, ++_num_loads });
+	_stats._bytes += bytes;
+	++_stats._num_textures;
+
+	evict(_budget);
+	return texture;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+TextureCache::setBudget(const std::size_t budget)
+{
+	std::lock_guard lock(_mutex);
+	_budget = budget;
+	evict(_budget);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+TextureCache::clear()
+{
+	std::lock_guard lock(_mutex);
+	evict(0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+TextureCache::Stats
+TextureCache::stats()
+const
+{
+	std::lock_guard lock(_mutex);
+	return _stats;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+TextureCache::evict(const std::size_t budget)
+{
+	while (_stats._bytes > budget) {
+		// Find the unused texture loaded the longest ago. There are only ever
+		// a handful of textures, so a scan is cheap enough.
+		auto victim = _entries.end();
+
+		for (auto it = _entries.begin(); it != _entries.end(); ++it) {
+			const bool is_unused = it->second._texture.use_count() == 1;
+
+			if (is_unused && (victim == _entries.end() ||
+				it->second._last_load < victim->second._last_load))
+			{
+				victim = it;
+			}
+		}
+
+		if (victim == _entries.end()) {
+			// Everything left is in use.
+			return;
+		}
+
+		NEMO_DEBUG("Evicted texture {}", victim->first);
+		_stats._bytes -= victim->second._bytes;
+		--_stats._num_textures;
+		++_stats._evictions;
+		_entries.erase(victim);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+}
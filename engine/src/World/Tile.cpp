@@ -6,8 +6,15 @@
 #include "World/Tile.hpp"
 #include "World/Tileset.hpp"
 #include "type/RowColumnIndex.hpp"
+#include "constants.hpp"
+
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/Vertex.hpp>
 
 #include <algorithm>
+#include <array>
+#include <utility>
+#include <vector>
 
 namespace nemo
 {
@@ -16,8 +23,53 @@ namespace nemo
 ////////////////////////////////////////////////////////////////////////////////
 
 Tile::Tile()
+noexcept
+	: _inline_layers{}
+	, _num_layers(0)
+	, _overflow_layers()
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+Tile::Tile(const Tile& other)
+	: _inline_layers(other._inline_layers)
+	, _num_layers(other._num_layers)
+	, _overflow_layers()
+{
+	if (other._overflow_layers) {
+		const std::size_t capacity = overflowCapacity(_num_layers);
+		_overflow_layers = std::make_unique< layer_t[] >(capacity);
+		std::copy_n(
+			other._overflow_layers.get(), _num_layers, _overflow_layers.get()
+		);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+Tile::Tile(Tile&& other)
+noexcept
+	: _inline_layers(other._inline_layers)
+	, _num_layers(other._num_layers)
+	, _overflow_layers(std::move(other._overflow_layers))
+{
+	other._num_layers = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+Tile&
+Tile::operator=(Tile other)
+noexcept
 {
-	allowWalk(false);
+	std::swap(_inline_layers, other._inline_layers);
+	std::swap(_num_layers, other._num_layers);
+	std::swap(_overflow_layers, other._overflow_layers);
+	return *this;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -26,54 +78,141 @@ Tile::Tile()
 void
 Tile::addTileIndex(const type::RowColumnIndex tile_idx)
 {
-	if (const auto duplicate = 
-			std::find(_tile_indices.cbegin(), _tile_indices.cend(), tile_idx);
-		duplicate != _tile_indices.cend())
-	{
-		// Avoid duplicate tile sprite indices. Just move the old one to the 
-		// back.
-		// std::rotate(duplicate, duplicate + 1, _tile_indices.cend());
+	const layer_t layer = packIndex(tile_idx);
+	const layer_t* const first = layers();
+
+	// Avoid duplicate tile sprite indices. Tiles have only a few layers, so a 
+	// linear search is as fast as anything else.
+	if (std::find(first, first + _num_layers, layer) != first + _num_layers) {
 		return;
 	}
 
+	addLayer(layer);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+Tile::addLayer(const layer_t layer)
+{
 	// Tile sprites are drawn in order of when the indices were added, so a 
 	// tile sprite whose indices are at the back would be the last drawn and, 
 	// thus, be the topmost sprite on screen.
-	_tile_indices.push_back(tile_idx);
+	if (_num_layers < _inline_capacity) {
+		_inline_layers[_num_layers++] = layer;
+		return;
+	}
+
+	// Move to a bigger overflow buffer when the inline one or the current 
+	// overflow buffer is full. Capacities double, so this rarely happens.
+	if (_num_layers == _inline_capacity || 
+		overflowCapacity(_num_layers) == _num_layers)
+	{
+		auto grown = std::make_unique< layer_t[] >(
+			overflowCapacity(_num_layers + 1u)
+		);
+
+		std::copy_n(layers(), _num_layers, grown.get());
+		_overflow_layers = std::move(grown);
+	}
+
+	_overflow_layers[_num_layers++] = layer;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
 void
-Tile::allowWalk(const bool walkable)
-noexcept
+Tile::drawSprite(
+	sf::RenderWindow&   window, 
+	const Tileset&      tileset
+) const
 {
-	_is_walkable = walkable;
+	if (_num_layers == 0) {
+		return;
+	}
+
+	// Draw every layer in one call rather than one sprite at a time. Stacks 
+	// stored inside the tile fit in a buffer on the stack, so only tiles with
+	// overflow layers allocate vertices.
+	constexpr std::size_t vertices_per_quad = 4;
+	std::array< sf::Vertex, _inline_capacity * vertices_per_quad > buffer;
+	std::vector< sf::Vertex > overflow;
+	sf::Vertex* vertices = buffer.data();
+
+	if (_num_layers > _inline_capacity) {
+		overflow.resize(_num_layers * vertices_per_quad);
+		vertices = overflow.data();
+	}
+
+	const auto length = static_cast< float >(constants::_tile_side_length);
+	const std::size_t num_quads = tileset.writeQuads(
+		layers(), _num_layers, sf::Vector2f(0.f, 0.f), length, vertices
+	);
+
+	window.draw(
+		vertices, num_quads * vertices_per_quad, sf::Quads, 
+		sf::RenderStates(&tileset.texture())
+	);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
-bool
-Tile::isWalkable()
+std::size_t
+Tile::numLayers()
 const noexcept
 {
-	return _is_walkable;
+	return _num_layers;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
-void
-Tile::drawSprite(
-	sf::RenderWindow&   window, 
-	const Tileset&      tileset
-) const
+const Tile::layer_t*
+Tile::layers()
+const noexcept
+{
+	return _overflow_layers ? _overflow_layers.get() : _inline_layers.data();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+Tile::layer_t
+Tile::packIndex(const type::RowColumnIndex tile_idx)
+noexcept
+{
+	return static_cast< layer_t >((tile_idx._r & 0xFFu) << 8u | 
+		(tile_idx._c & 0xFFu));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+type::RowColumnIndex
+Tile::unpackIndex(const layer_t layer)
+noexcept
+{
+	return { type::row_t(layer >> 8u), type::column_t(layer & 0xFFu) };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+std::size_t
+Tile::overflowCapacity(const std::size_t num_layers)
+noexcept
 {
-	for (const type::RowColumnIndex idx : _tile_indices) {
-		window.draw( tileset.getTileSprite(idx) );
+	// Smallest doubling of the inline capacity that fits the layers.
+	std::size_t capacity = _inline_capacity * 2;
+
+	while (capacity < num_layers) {
+		capacity *= 2;
 	}
+
+	return capacity;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,80 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \copyright MIT License                                                   ///
+/// \author    Caylen Lee                                                    ///
+/// \date      2019                                                          ///
+////////////////////////////////////////////////////////////////////////////////
+#include "World/TilePalette.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace nemo
+{
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+TilePalette::TilePalette()
+	: _tiles(1)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+std::optional< TilePalette::id_t >
+TilePalette::withLayer(const id_t id, const Tile::layer_t layer)
+{
+	const Tile& below = _tiles[id];
+	const Tile::layer_t* const first = below.layers();
+	const Tile::layer_t* const last = first + below.numLayers();
+
+	if (std::find(first, last, layer) != last) {
+		return id;
+	}
+
+	const std::uint32_t key = std::uint32_t(id) << 16u | layer;
+
+	if (const auto child = _children.find(key); child != _children.cend()) {
+		return child->second;
+	}
+
+	if (_tiles.size() >= _max_size) {
+		return std::nullopt;
+	}
+
+	// Copy before growing the palette, which may move the stack below.
+	Tile stack = below;
+	stack.addLayer(layer);
+	
+	const auto new_id = static_cast< id_t >(_tiles.size());
+	_tiles.push_back(std::move(stack));
+	_children.emplace(key, new_id);
+
+	return new_id;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+const Tile&
+TilePalette::tile(const id_t id)
+const noexcept
+{
+	return _tiles[id];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+std::size_t
+TilePalette::size()
+const noexcept
+{
+	return _tiles.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+}
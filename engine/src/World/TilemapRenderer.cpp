@@ -0,0 +1,284 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \copyright MIT License                                                   ///
+/// \author    Caylen Lee                                                    ///
+/// \date      2019                                                          ///
+////////////////////////////////////////////////////////////////////////////////
+#include "World/TilemapRenderer.hpp"
+#include "World/World.hpp"
+#include "World/Tileset.hpp"
+#include "World/Tile.hpp"
+#include "World/TilePalette.hpp"
+#include "type/RowColumnIndex.hpp"
+#include "constants.hpp"
+
+#include <SFML/Graphics/RenderStates.hpp>
+
+#include <algorithm>
+
+namespace nemo
+{
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+	/// Number of vertices that make up one tile sprite.
+	constexpr auto vertices_per_quad_ = 4;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+TilemapRenderer::TilemapRenderer(const World& world)
+	: _world(world)
+	, _num_chunk_columns(0)
+	, _tileset_revision(0)
+{
+	rebuild();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+bool
+TilemapRenderer::fitToWorld()
+{
+	const type::RowColumnIndex num_chunks = _world.chunkCount();
+	const std::size_t size = num_chunks._r * num_chunks._c;
+
+	if (_batches.size() == size && _num_chunk_columns == num_chunks._c) {
+		return false;
+	}
+
+	// Revision 0 is never handed out by a world, so every new batch is dirty.
+	const ChunkBatch empty_batch = { sf::VertexArray(sf::Quads), 0 };
+	_batches.assign(size, empty_batch);
+	_num_chunk_columns = num_chunks._c;
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+std::size_t
+TilemapRenderer::update()
+{
+	fitToWorld();
+
+	// Quads baked from another tileset hold its texture coordinates. Getting 
+	// the tileset loads it if it isn't yet, which changes its revision.
+	_world.tileset();
+
+	if (_tileset_revision != _world.tilesetRevision()) {
+		_tileset_revision = _world.tilesetRevision();
+
+		for (ChunkBatch& batch : _batches) {
+			batch._revision = 0;
+		}
+	}
+
+	std::size_t num_rebaked = 0;
+
+	for (std::size_t i = 0; i < _batches.size(); ++i) {
+		const type::RowColumnIndex chunk_index = {
+			type::row_t(static_cast< unsigned >(i / _num_chunk_columns)), 
+			type::column_t(static_cast< unsigned >(i % _num_chunk_columns))
+		};
+
+		if (_batches[i]._revision == _world.chunkRevision(chunk_index)) {
+			// Chunk hasn't changed since it was last baked.
+			continue;
+		}
+
+		bakeChunk(chunk_index, _batches[i]);
+		++num_rebaked;
+	}
+
+	return num_rebaked;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+TilemapRenderer::rebuild()
+{
+	if (!fitToWorld()) {
+		// Mark every batch dirty.
+		for (ChunkBatch& batch : _batches) {
+			batch._revision = 0;
+		}
+	}
+
+	update();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+TilemapRenderer::bakeChunk(
+	const type::RowColumnIndex chunk_index, 
+	ChunkBatch&                batch
+)
+{
+	constexpr auto side = constants::_chunk_side_length;
+	batch._vertices.clear();
+	batch._revision = _world.chunkRevision(chunk_index);
+	
+	const Tileset* tileset = _world.tileset();
+
+	if (!tileset) {
+		// Nothing to texture the tiles with.
+		return;
+	}
+
+	// Chunks at the bottom and right edges may hang off the area map.
+	const type::RowColumnIndex size = _world.size();
+	const unsigned first_row = chunk_index._r * side;
+	const unsigned first_col = chunk_index._c * side;
+	const unsigned last_row = std::min(first_row + side, size._r);
+	const unsigned last_col = std::min(first_col + side, size._c);
+
+	// Walk the chunk's palette ids and look up each distinct stack in the 
+	// small palette, instead of reading a whole tile per cell.
+	const TilePalette& palette = _world.palette();
+
+	for (unsigned r = first_row; r < last_row; ++r) {
+		for (unsigned c = first_col; c < last_col; ++c) {
+			const type::RowColumnIndex world_index = {
+				type::row_t(r), type::column_t(c)
+			};
+
+			const TilePalette::id_t id = _world.paletteId(world_index);
+
+			if (id == TilePalette::_empty_id) {
+				continue;
+			}
+
+			appendTile(
+				world_index, palette.tile(id), *tileset, batch._vertices
+			);
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+TilemapRenderer::appendTile(
+	const type::RowColumnIndex world_index,
+	const Tile&                tile,
+	const Tileset&             tileset,
+	sf::VertexArray&           vertices
+)
+{
+	constexpr auto length = static_cast< float >(constants::_tile_side_length);
+	const sf::Vector2f top_left = world_index.sfVector2< float >() * length;
+
+	const std::size_t num_layers = tile.numLayers();
+
+	if (num_layers == 0) {
+		return;
+	}
+
+	// Layers are appended bottommost first, so quads that come later in the
+	// vertex array are drawn on top, same as Tile::drawSprite.
+	const std::size_t offset = vertices.getVertexCount();
+	vertices.resize(offset + num_layers * vertices_per_quad_);
+
+	const std::size_t num_quads = tileset.writeQuads(
+		tile.layers(), num_layers, top_left, length, &vertices[offset]
+	);
+
+	vertices.resize(offset + num_quads * vertices_per_quad_);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+TilemapRenderer::draw(sf::RenderTarget& window)
+const
+{
+	const type::RowColumnIndex origin = { type::row_t(0), type::column_t(0) };
+	draw(window, origin, _world.size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+TilemapRenderer::draw(
+	sf::RenderTarget&          window,
+	const type::RowColumnIndex top_left,
+	const type::RowColumnIndex num_tiles
+) const
+{
+	constexpr auto side = constants::_chunk_side_length;
+	const Tileset* tileset = _world.tileset();
+
+	if (!tileset || num_tiles._r == 0 || num_tiles._c == 0 || 
+		_num_chunk_columns == 0)
+	{
+		return;
+	}
+
+	// Range of chunks overlapping the area, clamped to the baked chunks.
+	const auto num_chunk_rows = 
+		static_cast< unsigned >(_batches.size()) / _num_chunk_columns;
+	const unsigned last_row = top_left._r + num_tiles._r - 1;
+	const unsigned last_col = top_left._c + num_tiles._c - 1;
+	const unsigned first_chunk_row = top_left._r / side;
+	const unsigned first_chunk_col = top_left._c / side;
+	const unsigned end_chunk_row = std::min(last_row / side + 1, num_chunk_rows);
+	const unsigned end_chunk_col = 
+		std::min(last_col / side + 1, _num_chunk_columns);
+
+	const sf::RenderStates states(&tileset->texture());
+
+	for (unsigned r = first_chunk_row; r < end_chunk_row; ++r) {
+		for (unsigned c = first_chunk_col; c < end_chunk_col; ++c) {
+			const ChunkBatch& batch = _batches[r * _num_chunk_columns + c];
+
+			if (batch._vertices.getVertexCount() < vertices_per_quad_) {
+				// Skip empty chunks.
+				continue;
+			}
+
+			window.draw(batch._vertices, states);
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+std::size_t
+TilemapRenderer::drawCalls()
+const noexcept
+{
+	return std::count_if(
+		_batches.cbegin(), _batches.cend(), 
+		[] (const ChunkBatch& batch) {
+			return batch._vertices.getVertexCount() >= vertices_per_quad_;
+		}
+	);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+const World&
+TilemapRenderer::world()
+const noexcept
+{
+	return _world;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+}
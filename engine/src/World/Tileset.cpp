@@ -4,12 +4,17 @@
 /// \date      2019                                                          ///
 ////////////////////////////////////////////////////////////////////////////////
 #include "World/Tileset.hpp"
+#include "World/Tile.hpp"
 #include "type/RowColumnIndex.hpp"
+#include "TextureCache.hpp"
 #include "constants.hpp"
+#include "util/logger.hpp"
 
+#include <optional>
 #include <sstream>
 #include <algorithm>
 #include <exception>
+#include <utility>
 
 namespace nemo
 {
@@ -21,19 +26,81 @@ namespace {
 	// Default path to a tileset directory.
 	const std::filesystem::path tileset_dir_ = constants::_sprite_dir /
 		"tileset";
+
+	// Tileset images.
+	const std::filesystem::path urban_file_ = "urban.png";
+	const std::filesystem::path forest_file_ = "forest.png";
+
+	/**
+	 * \brief
+	 * Creates a tileset, drawing from an atlas if one is given and can be
+	 * packed.
+	 * 
+	 * \param file     Tileset image.
+	 * \param atlas    Unpacked atlas, or nullptr.
+	 * 
+	 * \return
+	 * Tileset.
+	 */
+	template< typename T >
+	std::unique_ptr< Tileset >
+	makeTileset_(
+		const std::filesystem::path&           file,
+		const std::shared_ptr< TextureAtlas >& atlas
+	)
+	{
+		if (atlas) {
+			// The image is decoded and uploaded once, into the atlas, without
+			// a texture of the tileset's own.
+			const std::optional< TextureAtlas::sheet_t > sheet = 
+				atlas->addSheet(file, constants::_tile_side_length);
+
+			if (sheet && atlas->pack()) {
+				return std::make_unique< T >(atlas, *sheet);
+			}
+
+			NEMO_WARN("Failed to pack {}; drawing from its own texture", file);
+		}
+
+		return std::make_unique< T >();
+	}
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
 Tileset::Tileset(const std::filesystem::path& file)
-	: _tile_side_length(constants::_tile_side_length)
+	: _texture(TextureCache::getInstance().load(file))
+	, _tile_side_length(constants::_tile_side_length)
+	, _atlas(nullptr)
+	, _sheet(0)
+	, _num_rows(0)
+	, _num_columns(0)
 {
-	if (!_texture.loadFromFile(file.string())) {
+	if (!_texture) {
 		std::stringstream err_msg;
 		err_msg << "Failed to load texture from " << file;
 		throw std::ios_base::failure(err_msg.str());
 	}
+
+	buildTexCoords();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+Tileset::Tileset(
+	std::shared_ptr< const TextureAtlas > atlas, 
+	const TextureAtlas::sheet_t           sheet
+)
+	: _texture(nullptr)
+	, _tile_side_length(constants::_tile_side_length)
+	, _atlas(std::move(atlas))
+	, _sheet(sheet)
+	, _num_rows(0)
+	, _num_columns(0)
+{
+	buildTexCoords();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -43,6 +110,7 @@ void
 Tileset::setTilePixelSize(const int length)
 {
 	_tile_side_length = length;
+	buildTexCoords();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -52,18 +120,139 @@ sf::Sprite
 Tileset::getTileSprite(const type::RowColumnIndex rc)
 const
 {
+	return sf::Sprite(texture(), getTileRect(rc));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+sf::IntRect
+Tileset::getTileRect(const type::RowColumnIndex rc)
+const noexcept
+{
+	if (_atlas) {
+		return _atlas->region(_sheet, rc)._rect;
+	}
+
 	const sf::Vector2i top_left = rc.sfVector2< int >() * _tile_side_length;
 	const sf::Vector2i size = { _tile_side_length, _tile_side_length };
 	
-	const sf::IntRect portion_to_crop(top_left, size);
-	return sf::Sprite(_texture, portion_to_crop);
+	return sf::IntRect(top_left, size);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+std::size_t
+Tileset::writeQuads(
+	const std::uint16_t* layers,
+	const std::size_t    count,
+	const sf::Vector2f   top_left,
+	const float          length,
+	sf::Vertex*          vertices
+) const noexcept
+{
+	const sf::Vector2f bottom_right = top_left + sf::Vector2f(length, length);
+	std::size_t num_quads = 0;
+
+	for (std::size_t i = 0; i < count; ++i) {
+		const type::RowColumnIndex rc = Tile::unpackIndex(layers[i]);
+
+		if (rc._r >= _num_rows || rc._c >= _num_columns) {
+			continue;
+		}
+
+		const TexCoords& tex = 
+			_tex_coords[std::size_t(rc._r) * _num_columns + rc._c];
+		
+		sf::Vertex* quad = vertices + num_quads * 4;
+		quad[0].position  = top_left;
+		quad[0].texCoords = tex._top_left;
+		quad[1].position  = { bottom_right.x, top_left.y };
+		quad[1].texCoords = { tex._bottom_right.x, tex._top_left.y };
+		quad[2].position  = bottom_right;
+		quad[2].texCoords = tex._bottom_right;
+		quad[3].position  = { top_left.x, bottom_right.y };
+		quad[3].texCoords = { tex._top_left.x, tex._bottom_right.y };
+		++num_quads;
+	}
+
+	return num_quads;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+const sf::Texture&
+Tileset::texture()
+const noexcept
+{
+	return _atlas ? _atlas->page(_atlas->pageOf(_sheet)) : *_texture;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+Tileset::buildTexCoords()
+{
+	_tex_coords.clear();
+	_num_rows = 0;
+	_num_columns = 0;
+
+	if (_tile_side_length <= 0) {
+		return;
+	}
+
+	if (_atlas) {
+		const type::RowColumnIndex size = _atlas->sheetSize(_sheet);
+		_num_rows = size._r;
+		_num_columns = size._c;
+	}
+	else {
+		const sf::Vector2u size = _texture->getSize();
+		const auto length = static_cast< unsigned >(_tile_side_length);
+		_num_rows = size.y / length;
+		_num_columns = size.x / length;
+	}
+	_tex_coords.reserve(std::size_t(_num_rows) * _num_columns);
+
+	for (unsigned r = 0; r < _num_rows; ++r) {
+		for (unsigned c = 0; c < _num_columns; ++c) {
+			const sf::IntRect rect = getTileRect({
+				type::row_t(r), type::column_t(c)
+			});
+
+			_tex_coords.push_back({
+				sf::Vector2f(
+					static_cast< float >(rect.left), 
+					static_cast< float >(rect.top)
+				),
+				sf::Vector2f(
+					static_cast< float >(rect.left + rect.width), 
+					static_cast< float >(rect.top + rect.height)
+				)
+			});
+		}
+	}
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
 UrbanTilemap::UrbanTilemap()
-	: Tileset("urban.png")
+	: Tileset(urban_file_)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+UrbanTilemap::UrbanTilemap(
+	std::shared_ptr< const TextureAtlas > atlas, 
+	const TextureAtlas::sheet_t           sheet
+)
+	: Tileset(std::move(atlas), sheet)
 {
 }
 
@@ -71,7 +260,18 @@ UrbanTilemap::UrbanTilemap()
 ////////////////////////////////////////////////////////////////////////////////
 
 ForestTilemap::ForestTilemap()
-	: Tileset("forest.png")
+	: Tileset(forest_file_)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+ForestTilemap::ForestTilemap(
+	std::shared_ptr< const TextureAtlas > atlas, 
+	const TextureAtlas::sheet_t           sheet
+)
+	: Tileset(std::move(atlas), sheet)
 {
 }
 
@@ -79,13 +279,16 @@ ForestTilemap::ForestTilemap()
 ////////////////////////////////////////////////////////////////////////////////
 
 std::unique_ptr< Tileset >
-makeTileset(const std::string_view& type)
+makeTileset(
+	const std::string_view&                type, 
+	const std::shared_ptr< TextureAtlas >& atlas
+)
 {
 	if (type == "urban") {
-		return std::make_unique< UrbanTilemap >();
+		return makeTileset_< UrbanTilemap >(urban_file_, atlas);
 	}
 	else if (type == "forest") {
-		return std::make_unique< ForestTilemap >();
+		return makeTileset_< ForestTilemap >(forest_file_, atlas);
 	}
 
 	return nullptr;
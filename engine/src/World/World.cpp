@@ -6,12 +6,29 @@
 #include "World/World.hpp"
 #include "World/Tileset.hpp"
 #include "World/Tile.hpp"
+#include "TextureAtlas.hpp"
 #include "type/RowColumnIndex.hpp"
 #include "util/readJsonFile.hpp"
 #include "util/logger.hpp"
 #include "constants.hpp"
 
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <nlohmann/json.hpp>
+
 #include <algorithm>
+#include <array>
+#include <bitset>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <initializer_list>
+#include <limits>
+#include <optional>
+#include <sstream>
+#include <string>
 
 namespace nemo
 {
@@ -26,65 +43,1138 @@ namespace
 	constexpr auto walkable_key_      = "walkable";
 
 	const std::filesystem::path world_dir_ = constants::_asset_dir / "world";
+
+	/// File extension of compiled area maps.
+	constexpr auto compiled_extension_ = ".nemomap";
+
+	/**
+	 * \brief
+	 * Header at the start of a compiled area map file.
+	 * 
+	 * A compiled area map is laid out as follows, in the host's (little-endian)
+	 * byte order:
+	 * 
+	 *     1. This header.
+	 * 
+	 *     2. Walkability bitset. Each row of tiles takes up a whole number of
+	 *        64-bit words; bit (c % 64) of word (c / 64) is set if the tile at
+	 *        column c is walkable.
+	 * 
+	 *     3. Palette of _num_stacks distinct sprite layer stacks, each made of
+	 *        _num_layers 16-bit tileset indices, bottommost first, with the 
+	 *        tileset row in the high byte and the column in the low byte. 
+	 *        Stacks with fewer layers are padded with \link empty_layer_.
+	 * 
+	 *     4. One 16-bit palette id per tile, in row-major order.
+	 */
+	struct CompiledHeader
+	{
+		char          _magic[8];     /// Always \link compiled_magic_.
+		std::uint32_t _version;      /// Always \link compiled_version_.
+		std::uint32_t _num_rows;     /// Rows of tiles.
+		std::uint32_t _num_columns;  /// Columns of tiles.
+		std::uint32_t _num_layers;   /// Most sprite layers per stack.
+		std::uint32_t _num_stacks;   /// Sprite layer stacks in the palette.
+		std::uint32_t _reserved;     /// Always 0.
+		char          _tileset[16];  /// Tileset name, null-padded.
+	};
+
+	constexpr char          compiled_magic_[8] = "NEMOMAP";
+	constexpr std::uint32_t compiled_version_  = 2;
+	constexpr std::uint16_t empty_layer_       = 0xFFFF;
+
+	/// Largest tileset row or column an area map can use. Row and column 255
+	/// would pack into \link empty_layer_, so they are kept free.
+	constexpr unsigned      max_sprite_index_  = 0xFEu;
+
+	static_assert(sizeof(CompiledHeader) % sizeof(std::uint64_t) == 0, 
+		"Walkability bitset following the header must be 64-bit aligned");
+
+	/**
+	 * \brief     Divides, rounding towards negative infinity.
+	 * \param a   Dividend.
+	 * \param b   Divisor. Must be positive.
+	 * \return    Quotient.
+	 */
+	constexpr long long
+	floor_div_(const long long a, const long long b)
+	noexcept
+	{
+		return a >= 0 ? a / b : -((-a + b - 1) / b);
+	}
+
+	/**
+	 * \brief          Gets a mask of bits [first, last] within a 64-bit word.
+	 * \param first    First bit.
+	 * \param last     Last bit, no less than \a first.
+	 * \return         Bit mask.
+	 */
+	constexpr std::uint64_t
+	bit_range_(const std::size_t first, const std::size_t last)
+	noexcept
+	{
+		return (~std::uint64_t(0) << first) & (~std::uint64_t(0) >> (63 - last));
+	}
+
+	/**
+	 * \brief          Gets the number of 64-bit words per row of walkability.
+	 * \param cols     Columns of tiles.
+	 * \return         Number of words.
+	 */
+	constexpr std::size_t
+	walkable_words_per_row_(const std::size_t cols)
+	noexcept
+	{
+		return (cols + 63) / 64;
+	}
+
+	/**
+	 * \brief            Multiplies sizes, checking for overflow.
+	 * \param a          Multiplicand.
+	 * \param b          Multiplier.
+	 * \param product    Set to the product if it fits.
+	 * \return           False if the product doesn't fit in a std::size_t.
+	 */
+	constexpr bool
+	checked_mul_(const std::size_t a, const std::size_t b, std::size_t& product)
+	noexcept
+	{
+		if (a != 0 && b > std::numeric_limits< std::size_t >::max() / a) {
+			return false;
+		}
+
+		product = a * b;
+		return true;
+	}
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
 World::World(const std::filesystem::path& file)
+	: _num_rows(0)
+	, _num_columns(0)
+	, _num_chunk_columns(0)
+	, _walkable_words_per_row(0)
+	, _is_tileset_loaded(false)
+	, _tileset_revision(0)
+{
+	if (file.extension() == compiled_extension_) {
+		loadCompiled(file);
+	}
+	else {
+		loadJson(file);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * \brief
+ * Streaming loader for json area maps.
+ * 
+ * This SAX handler writes tiles into the world as the json parser encounters 
+ * them, so the file is never held in memory as a whole json document. Parsing
+ * stops at the first syntax or schema error, which is kept in a message that 
+ * pinpoints the offending field, e.g. "tiles[12].world: ...".
+ * 
+ * The "size" property must precede "tiles", since the world's tile storage 
+ * has to be allocated before tiles can be written to it. Unknown properties 
+ * are skipped.
+ */
+class World::JsonLoader : public nlohmann::json_sax< nlohmann::json >
 {
-	const auto error_parse_failure = [&file] () {
-		NEMO_ERROR("Failed to load world map {}", file);
+public:
+	/**
+	 * \brief
+	 * Constructs a loader that writes into a world.
+	 * 
+	 * \param world
+	 * World to load the area map into.
+	 */
+	JsonLoader(World& world)
+		: _world(world)
+		, _state(State::Start)
+		, _skip_return(State::Start)
+		, _skip_depth(0)
+		, _num_tiles(0)
+		, _has_size(false)
+		, _has_tileset(false)
+	{
+	}
+
+	/**
+	 * \brief
+	 * Gets the first error that stopped parsing.
+	 * 
+	 * \return
+	 * Error message, or an empty string if parsing succeeded.
+	 */
+	const std::string&
+	error()
+	const noexcept
+	{
+		return _error;
+	}
+
+	bool
+	null()
+	override
+	{
+		return scalar("null");
+	}
+
+	bool
+	boolean(bool val)
+	override
+	{
+		if (_state == State::TileValue && _key == walkable_key_) {
+			_tile_walkable = val;
+			_state = State::Tile;
+			return true;
+		}
+
+		return scalar("boolean");
+	}
+
+	bool
+	number_integer(number_integer_t val)
+	override
+	{
+		if (val < 0 && isInPair()) {
+			return fail("expected unsigned integers");
+		}
+
+		return number_unsigned(static_cast< number_unsigned_t >(val));
+	}
+
+	bool
+	number_unsigned(number_unsigned_t val)
+	override
+	{
+		if (!isInPair()) {
+			return scalar("number");
+		}
+
+		if (_pair_size == _pair.size()) {
+			return fail("expected exactly 2 numbers");
+		}
+
+		if (val > std::numeric_limits< unsigned >::max()) {
+			return fail("number out of range");
+		}
+
+		_pair[_pair_size++] = static_cast< unsigned >(val);
+		return true;
+	}
+
+	bool
+	number_float(
+		[[maybe_unused]] number_float_t     val, 
+		[[maybe_unused]] const string_t&    s
+	) override
+	{
+		return isInPair() 
+			? fail("expected unsigned integers") 
+			: scalar("number");
+	}
+
+	bool
+	string(string_t& val)
+	override
+	{
+		if (_state == State::RootValue && _key == tileset_key_) {
+			_world.setTileset(val);
+			_has_tileset = true;
+			_state = State::Root;
+			return true;
+		}
+
+		return scalar("string");
+	}
+
+	bool
+	binary([[maybe_unused]] binary_t& val)
+	override
+	{
+		return scalar("binary");
+	}
+
+	bool
+	start_object([[maybe_unused]] std::size_t elements)
+	override
+	{
+		switch (_state) {
+			case State::Start:
+			_state = State::Root;
+			return true;
+
+			case State::TilesArray:
+			// New tile. Fields are validated once the whole object is read.
+			_tile_world.reset();
+			_tile_sprite.reset();
+			_tile_walkable.reset();
+			_state = State::Tile;
+			return true;
+
+			default:
+			return nested("object");
+		}
+	}
+
+	bool
+	key(string_t& val)
+	override
+	{
+		switch (_state) {
+			case State::Root:
+			_key = val;
+			_state = State::RootValue;
+			return true;
+
+			case State::Tile:
+			_key = val;
+			_state = State::TileValue;
+			return true;
+
+			default:
+			// Keys of skipped objects.
+			return true;
+		}
+	}
+
+	bool
+	end_object()
+	override
+	{
+		switch (_state) {
+			case State::Root:
+			_state = State::Done;
+			return finish();
+
+			case State::Tile:
+			if (!commitTile()) {
+				return false;
+			}
+
+			_state = State::TilesArray;
+			return true;
+
+			default:
+			return leaveNested();
+		}
+	}
+
+	bool
+	start_array([[maybe_unused]] std::size_t elements)
+	override
+	{
+		if (_state == State::RootValue && _key == size_key_) {
+			return enterPair(State::SizeArray);
+		}
+		
+		if (_state == State::RootValue && _key == layout_key_) {
+			if (!_has_size) {
+				return fail("\"size\" must come before \"tiles\"");
+			}
+
+			_state = State::TilesArray;
+			return true;
+		}
+
+		if (_state == State::TileValue && _key == world_index_key_) {
+			return enterPair(State::TileWorldArray);
+		}
+
+		if (_state == State::TileValue && _key == sprite_index_key_) {
+			return enterPair(State::TileSpriteArray);
+		}
+
+		return nested("array");
+	}
+
+	bool
+	end_array()
+	override
+	{
+		if (isInPair() && _pair_size != _pair.size()) {
+			return fail("expected exactly 2 numbers");
+		}
+
+		switch (_state) {
+			case State::SizeArray:
+			_world.resetToSize(_pair);
+			_has_size = true;
+			_state = State::Root;
+			return true;
+
+			case State::TileWorldArray:
+			_tile_world = _pair;
+			_state = State::Tile;
+			return true;
+
+			case State::TileSpriteArray:
+			_tile_sprite = _pair;
+			_state = State::Tile;
+			return true;
+
+			case State::TilesArray:
+			_state = State::Root;
+			return true;
+
+			default:
+			return leaveNested();
+		}
+	}
+
+	bool
+	parse_error(
+		std::size_t                          position,
+		[[maybe_unused]] const std::string&  last_token,
+		const nlohmann::detail::exception&   ex
+	) override
+	{
+		std::stringstream err_msg;
+		err_msg << "syntax error at byte " << position << ": " << ex.what();
+		_error = err_msg.str();
+		return false;
+	}
+
+private:
+	/**
+	 * \brief
+	 * Where the parser is in the area map's json schema.
+	 */
+	enum class State
+	{
+		Start,           /// Before the root object.
+		Root,            /// In the root object, expecting a key.
+		RootValue,       /// Expecting the value of a root property.
+		SizeArray,       /// In the "size" array.
+		TilesArray,      /// In the "tiles" array, expecting a tile.
+		Tile,            /// In a tile object, expecting a key.
+		TileValue,       /// Expecting the value of a tile property.
+		TileWorldArray,  /// In a tile's "world" array.
+		TileSpriteArray, /// In a tile's "sprite" array.
+		Skip,            /// In the value of an unknown property.
+		Done             /// After the root object.
 	};
 
-	const std::optional< nlohmann::json > config = util::readJsonFile(file);
+	using pair_t = std::array< unsigned, 2 >;
+
+	/**
+	 * \brief
+	 * Checks whether the parser is in a 2-number array.
+	 */
+	bool
+	isInPair()
+	const noexcept
+	{
+		return _state == State::SizeArray || 
+			_state == State::TileWorldArray || 
+			_state == State::TileSpriteArray;
+	}
+
+	/**
+	 * \brief
+	 * Starts reading a 2-number array.
+	 */
+	bool
+	enterPair(const State state)
+	noexcept
+	{
+		_pair_size = 0;
+		_state = state;
+		return true;
+	}
+
+	/**
+	 * \brief
+	 * Handles a scalar value that the schema doesn't expect.
+	 * 
+	 * \param type
+	 * Json type of the value, for the error message.
+	 */
+	bool
+	scalar(const std::string_view& type)
+	{
+		switch (_state) {
+			case State::RootValue:
+			if (isKnownRootKey()) {
+				return fail("unexpected " + std::string(type));
+			}
+			
+			_state = State::Root;
+			return true;
+
+			case State::TileValue:
+			if (isKnownTileKey()) {
+				return fail("unexpected " + std::string(type));
+			}
+
+			_state = State::Tile;
+			return true;
+
+			case State::Skip:
+			return true;
+
+			default:
+			return fail("unexpected " + std::string(type));
+		}
+	}
+
+	/**
+	 * \brief
+	 * Handles an object or array that the schema doesn't expect.
+	 * 
+	 * \param type
+	 * Json type of the value, for the error message.
+	 */
+	bool
+	nested(const std::string_view& type)
+	{
+		switch (_state) {
+			case State::RootValue:
+			if (isKnownRootKey()) {
+				return fail("unexpected " + std::string(type));
+			}
+
+			_skip_return = State::Root;
+			break;
+
+			case State::TileValue:
+			if (isKnownTileKey()) {
+				return fail("unexpected " + std::string(type));
+			}
+
+			_skip_return = State::Tile;
+			break;
+
+			case State::Skip:
+			break;
+
+			default:
+			return fail("unexpected " + std::string(type));
+		}
+
+		// Skip the unknown property's value, however deep it goes.
+		_state = State::Skip;
+		++_skip_depth;
+		return true;
+	}
+
+	/**
+	 * \brief
+	 * Handles the end of an object or array being skipped.
+	 */
+	bool
+	leaveNested()
+	noexcept
+	{
+		if (--_skip_depth == 0) {
+			_state = _skip_return;
+		}
+
+		return true;
+	}
+
+	bool
+	isKnownRootKey()
+	const noexcept
+	{
+		return _key == size_key_ || _key == tileset_key_ || 
+			_key == layout_key_;
+	}
+
+	bool
+	isKnownTileKey()
+	const noexcept
+	{
+		return _key == world_index_key_ || _key == sprite_index_key_ || 
+			_key == walkable_key_;
+	}
+
+	/**
+	 * \brief
+	 * Writes the tile that was just read into the world.
+	 */
+	bool
+	commitTile()
+	{
+		if (!_tile_world || !_tile_sprite || !_tile_walkable) {
+			return fail("missing \"world\", \"sprite\", or \"walkable\"");
+		}
+
+		const type::RowColumnIndex world_index = *_tile_world;
+		const type::RowColumnIndex size = _world.size();
+
+		if (world_index._r >= size._r || world_index._c >= size._c) {
+			return fail("\"world\" index out of bounds");
+		}
+
+		// Tiles store sprite layers packed into 8 bits per row and column.
+		if (_tile_sprite->front() > max_sprite_index_ || 
+			_tile_sprite->back() > max_sprite_index_)
+		{
+			return fail("\"sprite\" index too large");
+		}
+
+		if (!_world.addTileIndex(world_index, *_tile_sprite)) {
+			return fail("too many distinct sprite stacks");
+		}
+
+		_world.allowWalk(world_index, *_tile_walkable);
+
+		++_num_tiles;
+		return true;
+	}
+
+	/**
+	 * \brief
+	 * Checks that the root object had all the required properties.
+	 */
+	bool
+	finish()
+	{
+		if (!_has_size || !_has_tileset) {
+			_error = "missing \"size\" or \"tileset\"";
+			return false;
+		}
+
+		return true;
+	}
+
+	/**
+	 * \brief
+	 * Stops parsing with an error at the current field.
+	 * 
+	 * \param what
+	 * Description of the error.
+	 */
+	bool
+	fail(const std::string& what)
+	{
+		std::stringstream err_msg;
+
+		switch (_state) {
+			case State::Tile:
+			case State::TileValue:
+			case State::TileWorldArray:
+			case State::TileSpriteArray:
+			err_msg << layout_key_ << "[" << _num_tiles << "]";
+
+			if (_state != State::Tile) {
+				err_msg << "." << _key;
+			}
+
+			break;
+
+			case State::RootValue:
+			case State::SizeArray:
+			err_msg << _key;
+			break;
+
+			default:
+			err_msg << "root";
+			break;
+		}
+
+		err_msg << ": " << what;
+		_error = err_msg.str();
+		return false;
+	}
+
+	/// World to load the area map into.
+	World&                   _world;
+
+	/// Current position in the schema.
+	State                    _state;
+
+	/// State to go back to once the skipped value ends.
+	State                    _skip_return;
+
+	/// Nesting depth in the skipped value.
+	unsigned                 _skip_depth;
+
+	/// Latest property key.
+	std::string              _key;
+
+	/// Numbers read so far in the current 2-number array.
+	pair_t                   _pair;
+	std::size_t              _pair_size;
+
+	/// Fields of the tile being read.
+	std::optional< pair_t >  _tile_world;
+	std::optional< pair_t >  _tile_sprite;
+	std::optional< bool >    _tile_walkable;
+
+	/// Number of tiles read so far.
+	std::size_t              _num_tiles;
+
+	/// Whether required root properties were read.
+	bool                     _has_size;
+	bool                     _has_tileset;
+
+	/// First error that stopped parsing.
+	std::string              _error;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+World::loadJson(const std::filesystem::path& file)
+{
+	std::ifstream ifs(file);
+
+	if (!ifs) {
+		NEMO_ERROR("Failed to open world map {}", file);
+		return;
+	}
+
+	// Stream the file through the loader instead of building a json document, 
+	// which would take several times the file's size in memory.
+	JsonLoader loader(*this);
+
+	if (!nlohmann::json::sax_parse(ifs, &loader)) {
+		NEMO_ERROR("Failed to load world map {}: {}", file, loader.error());
+		
+		// Don't leave a partially loaded area map behind.
+		resetToSize({ type::row_t(0), type::column_t(0) });
+		return;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+World::loadCompiled(const std::filesystem::path& file)
+{
+	namespace bip = boost::interprocess;
+	bip::mapped_region region;
+
+	try {
+		const bip::file_mapping mapping(file.string().c_str(), bip::read_only);
+		region = bip::mapped_region(mapping, bip::read_only);
+	}
+	catch (const bip::interprocess_exception& e) {
+		NEMO_ERROR("Failed to map world map {}: {}", file, e.what());
+		return;
+	}
+
+	const auto* bytes = static_cast< const unsigned char* >(region.get_address());
+	const std::size_t num_bytes = region.get_size();
+	CompiledHeader header;
+
+	if (num_bytes < sizeof(header)) {
+		NEMO_ERROR("Truncated header in world map {}", file);
+		return;
+	}
+
+	std::memcpy(&header, bytes, sizeof(header));
+
+	if (std::memcmp(header._magic, compiled_magic_, sizeof(header._magic)) != 0 
+		|| header._version != compiled_version_)
+	{
+		NEMO_ERROR("Unsupported world map format in {}", file);
+		return;
+	}
+
+	// Every stack but the empty one has layers, and ids are 16-bit.
+	const bool palette_fits = header._num_layers > 0
+		? header._num_stacks >= 1 && 
+			header._num_stacks <= TilePalette::_max_size
+		: header._num_stacks == 1;
+
+	if (!palette_fits) {
+		NEMO_ERROR("Invalid palette size in world map {}", file);
+		return;
+	}
+
+	const std::size_t rows = header._num_rows;
+	const std::size_t cols = header._num_columns;
+	const std::size_t words_per_row = walkable_words_per_row_(cols);
+	std::size_t walkable_bytes = 0;
+	std::size_t palette_bytes = 0;
+	std::size_t id_bytes = 0;
+
+	// Sizes come from the file, so don't let a corrupt one wrap them around.
+	if (!checked_mul_(rows, words_per_row, walkable_bytes) || 
+		!checked_mul_(walkable_bytes, sizeof(std::uint64_t), walkable_bytes) || 
+		!checked_mul_(header._num_stacks, header._num_layers, palette_bytes) || 
+		!checked_mul_(palette_bytes, sizeof(std::uint16_t), palette_bytes) || 
+		!checked_mul_(rows, cols, id_bytes) || 
+		!checked_mul_(id_bytes, sizeof(std::uint16_t), id_bytes))
+	{
+		NEMO_ERROR("Invalid dimensions in world map {}", file);
+		return;
+	}
+
+	// Check each section against what's left, so the sum can't overflow.
+	std::size_t remaining = num_bytes - sizeof(header);
+	bool truncated = false;
+
+	for (const std::size_t section : { walkable_bytes, palette_bytes, id_bytes }) {
+		if (section > remaining) {
+			truncated = true;
+			break;
+		}
+
+		remaining -= section;
+	}
+
+	if (truncated) {
+		NEMO_ERROR("Truncated tile data in world map {}", file);
+		return;
+	}
+
+	const char* tileset_end = std::find(
+		std::cbegin(header._tileset), std::cend(header._tileset), '\0'
+	);
+	const std::string_view tileset(
+		header._tileset, static_cast< std::size_t >(tileset_end - header._tileset)
+	);
+
+	setTileset(tileset);
+	resetToSize({ 
+		type::row_t(header._num_rows), type::column_t(header._num_columns) 
+	});
+
+	// Read the tile data straight out of the mapped file. The sections are 
+	// 64-bit aligned from the start of the mapping, which is page aligned.
+	const auto* stacks = reinterpret_cast< const std::uint16_t* >(
+		bytes + sizeof(header) + walkable_bytes
+	);
+	const auto* ids = reinterpret_cast< const std::uint16_t* >(
+		bytes + sizeof(header) + walkable_bytes + palette_bytes
+	);
+
+	// The walkability bitset is stored in the same layout as in memory.
+	std::memcpy(_walkable.data(), bytes + sizeof(header), walkable_bytes);
+
+	// Intern the file's stacks, which were already deduplicated when the map 
+	// was compiled, and map the file's ids to ours.
+	std::vector< TilePalette::id_t > palette_ids(header._num_stacks);
+
+	for (std::size_t i = 0; i < palette_ids.size(); ++i) {
+		TilePalette::id_t id = TilePalette::_empty_id;
+
+		for (std::size_t l = 0; l < header._num_layers; ++l) {
+			const std::uint16_t idx = stacks[i * header._num_layers + l];
+
+			if (idx == empty_layer_) {
+				break;
+			}
+
+			const std::optional< TilePalette::id_t > stacked = 
+				_palette.withLayer(id, idx);
+
+			if (!stacked) {
+				NEMO_ERROR("Too many distinct sprite stacks in {}", file);
+				resetToSize({ type::row_t(0), type::column_t(0) });
+				return;
+			}
+
+			id = *stacked;
+		}
+
+		palette_ids[i] = id;
+	}
+
+	for (std::size_t r = 0; r < rows; ++r) {
+		for (std::size_t c = 0; c < cols; ++c) {
+			const std::uint16_t id = ids[r * cols + c];
+
+			if (id >= palette_ids.size()) {
+				NEMO_ERROR("Palette id out of bounds in world map {}", file);
+				resetToSize({ type::row_t(0), type::column_t(0) });
+				return;
+			}
+
+			const type::RowColumnIndex world_index = {
+				type::row_t(static_cast< unsigned >(r)), 
+				type::column_t(static_cast< unsigned >(c))
+			};
+
+			// The chunks are brand new, so there's no revision to bump.
+			getChunk(world_index)._ids[offsetInChunk(world_index)] = 
+				palette_ids[id];
+		}
+	}
+
+	NEMO_INFO("Loaded compiled world map {}", file);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+bool
+World::compile(
+	const std::filesystem::path& json_file, 
+	const std::filesystem::path& compiled_file
+)
+{
+	const std::optional< nlohmann::json > config = util::readJsonFile(json_file);
 
 	if (!config) {
-		error_parse_failure();
+		NEMO_ERROR("Failed to load world map {}", json_file);
+		return false;
 	}
 
+	CompiledHeader header = {};
+	std::memcpy(header._magic, compiled_magic_, sizeof(header._magic));
+	header._version = compiled_version_;
+
+	// Distinct sprite layer stacks, and the stack of each tile in row-major
+	// order.
+	TilePalette palette;
+	std::vector< TilePalette::id_t > tile_ids;
+	std::vector< std::uint64_t > walkable;
+	std::size_t words_per_row = 0;
+
 	try {
 		using indices_t = std::array< unsigned, 2 >;
 
-		setTileset( config->at(tileset_key_).get< std::string_view >() );
-		resetToSize( config->at(size_key_).get< indices_t >() );
+		const auto tileset = config->at(tileset_key_).get< std::string >();
+		
+		if (tileset.size() >= sizeof(header._tileset)) {
+			NEMO_ERROR("Tileset name {} too long in {}", tileset, json_file);
+			return false;
+		}
+		
+		std::memcpy(header._tileset, tileset.data(), tileset.size());
+
+		const auto size = config->at(size_key_).get< indices_t >();
+		header._num_rows = size.front();
+		header._num_columns = size.back();
+		words_per_row = walkable_words_per_row_(header._num_columns);
 		
+		tile_ids.assign(
+			std::size_t(header._num_rows) * header._num_columns, 
+			TilePalette::_empty_id
+		);
+		walkable.resize(header._num_rows * words_per_row);
+
 		for (const auto& tile : config->at(layout_key_)) {
 			const auto world_index = tile.at(world_index_key_).get< indices_t >();
-	
-			getTile(world_index).addTileIndex(
-				tile.at(sprite_index_key_).get< indices_t >()
-			);
+			const auto sprite_index = tile.at(sprite_index_key_).get< indices_t >();
+			const auto [r, c] = world_index;
 
-			getTile(world_index).allowWalk(
-				tile.at(walkable_key_).get< bool >()
-			);
+			if (r >= header._num_rows || c >= header._num_columns) {
+				NEMO_ERROR("Tile [{}, {}] out of bounds in {}", r, c, json_file);
+				return false;
+			}
+
+			if (sprite_index.front() > max_sprite_index_ || 
+				sprite_index.back() > max_sprite_index_)
+			{
+				NEMO_ERROR("Tileset index too large in {}", json_file);
+				return false;
+			}
+
+			// Same as Tile::addTileIndex, skip duplicate sprites.
+			auto& id = tile_ids[std::size_t(r) * header._num_columns + c];
+			const std::optional< TilePalette::id_t > stacked = 
+				palette.withLayer(id, Tile::packIndex(sprite_index));
+
+			if (!stacked) {
+				NEMO_ERROR("Too many distinct sprite stacks in {}", json_file);
+				return false;
+			}
+
+			id = *stacked;
+
+			const std::uint64_t bit = std::uint64_t(1) << (c % 64);
+			std::uint64_t& word = walkable[r * words_per_row + c / 64];
+			word = tile.at(walkable_key_).get< bool >() ? word | bit : word & ~bit;
 		}
 	}
-	catch (const nlohmann::json::out_of_range& e) {
-		error_parse_failure();
+	catch (const nlohmann::json::exception& e) {
+		NEMO_ERROR("Failed to compile world map {}: {}", json_file, e.what());
+		return false;
+	}
+
+	header._num_stacks = static_cast< std::uint32_t >(palette.size());
+
+	for (std::size_t i = 0; i < palette.size(); ++i) {
+		header._num_layers = std::max(
+			header._num_layers, 
+			static_cast< std::uint32_t >(
+				palette.tile(static_cast< TilePalette::id_t >(i)).numLayers()
+			)
+		);
+	}
+
+	// Flatten the palette, padding short stacks.
+	std::vector< std::uint16_t > stacks(
+		header._num_layers * palette.size(), empty_layer_
+	);
+
+	for (std::size_t i = 0; i < palette.size(); ++i) {
+		const Tile& tile = palette.tile(static_cast< TilePalette::id_t >(i));
+		std::copy_n(
+			tile.layers(), tile.numLayers(), &stacks[i * header._num_layers]
+		);
 	}
+
+	std::error_code ec;
+	std::filesystem::create_directories(compiled_file.parent_path(), ec);
+	std::ofstream ofs(compiled_file, std::ios::binary);
+
+	ofs.write(reinterpret_cast< const char* >(&header), sizeof(header));
+	ofs.write(
+		reinterpret_cast< const char* >(walkable.data()), 
+		walkable.size() * sizeof(std::uint64_t)
+	);
+	ofs.write(
+		reinterpret_cast< const char* >(stacks.data()), 
+		stacks.size() * sizeof(std::uint16_t)
+	);
+	ofs.write(
+		reinterpret_cast< const char* >(tile_ids.data()), 
+		tile_ids.size() * sizeof(std::uint16_t)
+	);
+
+	if (!ofs) {
+		NEMO_ERROR("Write error in {}", compiled_file);
+		return false;
+	}
+
+	NEMO_INFO("Compiled world map {} to {}", json_file, compiled_file);
+	return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+World::~World() = default;
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 void
 World::resetToSize(const type::RowColumnIndex num_tiles)
 {
-	const auto rows = static_cast< int >(num_tiles._r);
-	const auto cols = static_cast< int >(num_tiles._c);
+	constexpr auto side = constants::_chunk_side_length;
+	
+	_num_rows = num_tiles._r;
+	_num_columns = num_tiles._c;
+
+	// Round up so that partially covered chunks at the edges are included.
+	const unsigned chunk_rows = (_num_rows + side - 1) / side;
+	_num_chunk_columns = (_num_columns + side - 1) / side;
+
+	// Start the new chunks past every revision handed out so far, so renderers
+	// holding chunks of the old layout treat all of the new ones as dirty.
+	unsigned revision = 1;
+
+	for (const Chunk& chunk : _chunks) {
+		revision = std::max(revision, chunk._revision + 1);
+	}
+
+	const Chunk empty_chunk = { 
+		std::vector< TilePalette::id_t >(side * side, TilePalette::_empty_id), 
+		revision 
+	};
+	_chunks.assign(chunk_rows * _num_chunk_columns, empty_chunk);
+	_palette = TilePalette();
+
+	// Tiles are non-walkable until told otherwise.
+	_walkable_words_per_row = walkable_words_per_row_(_num_columns);
+	_walkable.assign(_num_rows * _walkable_words_per_row, 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+const World::Chunk&
+World::getChunk(const type::RowColumnIndex world_index)
+const
+{
+	constexpr auto side = constants::_chunk_side_length;
+	const unsigned chunk_row = world_index._r / side;
+	const unsigned chunk_col = world_index._c / side;
 
-	_tiles = tile_array_t(boost::extents[rows][cols]);
+	return _chunks[chunk_row * _num_chunk_columns + chunk_col];
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
-Tile&
-World::getTile(const type::RowColumnIndex world_index)
+World::Chunk&
+World::getChunk(const type::RowColumnIndex world_index)
+{
+	constexpr auto side = constants::_chunk_side_length;
+	const unsigned chunk_row = world_index._r / side;
+	const unsigned chunk_col = world_index._c / side;
+
+	return _chunks[chunk_row * _num_chunk_columns + chunk_col];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+std::size_t
+World::offsetInChunk(const type::RowColumnIndex world_index)
+noexcept
+{
+	constexpr auto side = constants::_chunk_side_length;
+	return (world_index._r % side) * side + world_index._c % side;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+bool
+World::addTileIndex(
+	const type::RowColumnIndex world_index, 
+	const type::RowColumnIndex tile_idx
+)
+{
+	if (world_index._r >= _num_rows || world_index._c >= _num_columns) {
+		return false;
+	}
+
+	Chunk& chunk = getChunk(world_index);
+	TilePalette::id_t& id = chunk._ids[offsetInChunk(world_index)];
+	
+	const std::optional< TilePalette::id_t > stacked = 
+		_palette.withLayer(id, Tile::packIndex(tile_idx));
+
+	if (!stacked) {
+		return false;
+	}
+
+	if (*stacked != id) {
+		// Don't make renderers rebake the chunk if the sprite was already 
+		// there.
+		id = *stacked;
+		++chunk._revision;
+	}
+
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+TilePalette::id_t
+World::paletteId(const type::RowColumnIndex world_index)
+const
 {
-	return _tiles[world_index._r][world_index._c];
+	return getChunk(world_index)._ids[offsetInChunk(world_index)];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+const TilePalette&
+World::palette()
+const noexcept
+{
+	return _palette;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -94,7 +1184,7 @@ const Tile&
 World::getTile(const type::RowColumnIndex world_index)
 const
 {
-	return _tiles[world_index._r][world_index._c];
+	return _palette.tile(paletteId(world_index));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -103,18 +1193,409 @@ const
 void
 World::setTileset(const std::string_view& type)
 {
-	_tileset = makeTileset(type);
+	// Textures need a graphics context, so the tileset isn't loaded until the
+	// area map is first drawn. Headless runs never load it.
+	_tileset_type = type;
+	releaseTileset();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+World::releaseTileset()
+noexcept
+{
+	_tileset = nullptr;
+	_is_tileset_loaded = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+type::RowColumnIndex
+World::size()
+const noexcept
+{
+	return { type::row_t(_num_rows), type::column_t(_num_columns) };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+const Tileset*
+World::tileset()
+const
+{
+	if (_is_tileset_loaded) {
+		return _tileset.get();
+	}
+
+	// Only try once, rather than on every frame if the tileset is missing. The
+	// tiles' layout and walkability are still usable without their sprites.
+	_is_tileset_loaded = true;
+	++_tileset_revision;
+
+	try {
+		// The area map owns the atlas its tileset is packed into, through the
+		// tileset, so it's released along with the tileset.
+		_tileset = makeTileset(_tileset_type, std::make_shared< TextureAtlas >());
+	}
+	catch (const std::exception& e) {
+		NEMO_ERROR("Failed to load tileset {}: {}", _tileset_type, e.what());
+		_tileset = nullptr;
+	}
+
+	return _tileset.get();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned
+World::tilesetRevision()
+const noexcept
+{
+	return _tileset_revision;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+type::RowColumnIndex
+World::chunkCount()
+const noexcept
+{
+	const auto chunk_rows = _num_chunk_columns == 0
+		? 0u 
+		: static_cast< unsigned >(_chunks.size()) / _num_chunk_columns;
+
+	return { type::row_t(chunk_rows), type::column_t(_num_chunk_columns) };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned
+World::chunkRevision(const type::RowColumnIndex chunk_index)
+const noexcept
+{
+	return _chunks[chunk_index._r * _num_chunk_columns + chunk_index._c]._revision;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
 TutorialWorld::TutorialWorld()
-	: World(world_dir_ / "tutorial.json")
+	: World(
+		std::filesystem::exists(world_dir_ / "tutorial.nemomap")
+			? world_dir_ / "tutorial.nemomap"
+			: world_dir_ / "tutorial.json"
+	)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+World::allowWalk(const type::RowColumnIndex world_index, const bool walkable)
+noexcept
+{
+	// Tiles outside the area map are never walkable, and there's no bit to 
+	// set for them.
+	if (world_index._r >= _num_rows || world_index._c >= _num_columns) {
+		return;
+	}
+
+	std::uint64_t& word = _walkable[
+		world_index._r * _walkable_words_per_row + world_index._c / 64
+	];
+	const std::uint64_t bit = std::uint64_t(1) << (world_index._c % 64);
+
+	word = walkable ? word | bit : word & ~bit;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+bool
+World::isWalkable(const type::RowColumnIndex world_index)
+const noexcept
+{
+	if (world_index._r >= _num_rows || world_index._c >= _num_columns) {
+		return false;
+	}
+
+	const std::uint64_t word = _walkable[
+		world_index._r * _walkable_words_per_row + world_index._c / 64
+	];
+
+	return (word >> (world_index._c % 64)) & 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+bool
+World::isWalkable(
+	const type::RowColumnIndex top_left, 
+	const type::RowColumnIndex num_tiles
+) const noexcept
+{
+	return isAreaWalkable(top_left._r, top_left._c, num_tiles._r, num_tiles._c);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+bool
+World::isAreaWalkable(
+	const long long row,
+	const long long column,
+	const long long num_rows,
+	const long long num_cols
+) const noexcept
+{
+	if (num_rows <= 0 || num_cols <= 0) {
+		return true;
+	}
+
+	if (row < 0 || column < 0 || row + num_rows > _num_rows || 
+		column + num_cols > _num_columns)
+	{
+		// Outside of the area map is never walkable.
+		return false;
+	}
+
+	const auto first_col = static_cast< std::size_t >(column);
+	const auto last_col = static_cast< std::size_t >(column + num_cols - 1);
+	const std::size_t first_word = first_col / 64;
+	const std::size_t last_word = last_col / 64;
+	const auto end_row = static_cast< std::size_t >(row + num_rows);
+
+	for (auto r = static_cast< std::size_t >(row); r < end_row; ++r) {
+		const std::uint64_t* words = &_walkable[r * _walkable_words_per_row];
+
+		// Test all of a row's tiles within one word at a time.
+		for (std::size_t w = first_word; w <= last_word; ++w) {
+			const std::uint64_t mask = bit_range_(
+				w == first_word ? first_col % 64 : 0,
+				w == last_word ? last_col % 64 : 63
+			);
+
+			if ((words[w] & mask) != mask) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+std::optional< type::RowColumnIndex >
+World::findBlocked(
+	const long long row,
+	const long long column,
+	const long long num_rows,
+	const long long num_cols
+) const noexcept
+{
+	// Only the part of the area inside the area map has tiles.
+	const long long first_row = std::max(row, 0LL);
+	const long long first_col = std::max(column, 0LL);
+	const long long end_row = std::min(row + num_rows, (long long)_num_rows);
+	const long long end_col = std::min(column + num_cols, (long long)_num_columns);
+
+	for (long long r = first_row; r < end_row; ++r) {
+		for (long long c = first_col; c < end_col; ++c) {
+			const type::RowColumnIndex world_index = {
+				type::row_t(static_cast< unsigned >(r)), 
+				type::column_t(static_cast< unsigned >(c))
+			};
+
+			if (!isWalkable(world_index)) {
+				return world_index;
+			}
+		}
+	}
+
+	return {};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+World::SweepResult
+World::sweepBox(
+	const type::Vector2 position,
+	const type::Vector2 size,
+	const type::Vector2 displacement
+) const noexcept
+{
+	constexpr long long length = constants::_tile_side_length;
+	SweepResult result = { displacement, false, std::nullopt };
+
+	long long x = type_safe::get(position._x);
+	long long y = type_safe::get(position._y);
+	long long dx = type_safe::get(displacement._x);
+	long long dy = type_safe::get(displacement._y);
+	const long long w = type_safe::get(size._x);
+	const long long h = type_safe::get(size._y);
+
+	if (w <= 0 || h <= 0) {
+		return result;
+	}
+
+	// Moves the box's leading edge along one axis, one line of tiles at a time.
+	// Returns the line of tiles that stopped it, if any.
+	const auto sweep_axis = [this, &result] (
+		const long long edge,   // Leading edge, in pixels.
+		long long&      delta,  // Distance to move, clamped if stopped.
+		const auto&     is_line_walkable
+	) -> std::optional< long long >
+	{
+		const long long step = delta > 0 ? 1 : -1;
+		const long long from = floor_div_(edge, length);
+		const long long to = floor_div_(edge + delta, length);
+
+		// Only test the lines of tiles the edge moves into.
+		for (long long line = from + step; line != to + step; line += step) {
+			if (is_line_walkable(line)) {
+				continue;
+			}
+
+			// Stop flush against the line of tiles.
+			delta = delta > 0 
+				? line * length - 1 - edge 
+				: (line + 1) * length - edge;
+
+			result._is_blocked = true;
+			return line;
+		}
+
+		return {};
+	};
+
+	if (dx != 0) {
+		// Rows of tiles spanned by the box.
+		const long long row = floor_div_(y, length);
+		const long long num_rows = floor_div_(y + h - 1, length) - row + 1;
+		const long long edge = dx > 0 ? x + w - 1 : x;
+
+		const auto column = sweep_axis(edge, dx, [&] (const long long c) {
+			return isAreaWalkable(row, c, num_rows, 1);
+		});
+
+		if (column) {
+			result._contact = findBlocked(row, *column, num_rows, 1);
+		}
+
+		x += dx;
+	}
+
+	if (dy != 0) {
+		// Columns of tiles spanned by the box, after moving along the x-axis.
+		const long long column = floor_div_(x, length);
+		const long long num_cols = floor_div_(x + w - 1, length) - column + 1;
+		const long long edge = dy > 0 ? y + h - 1 : y;
+
+		const auto row = sweep_axis(edge, dy, [&] (const long long r) {
+			return isAreaWalkable(r, column, 1, num_cols);
+		});
+
+		if (row && !result._contact) {
+			result._contact = findBlocked(*row, column, 1, num_cols);
+		}
+	}
+
+	result._displacement = { 
+		type::x_t(static_cast< int >(dx)), type::y_t(static_cast< int >(dy))
+	};
+
+	return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+std::size_t
+World::countBlocked(
+	const type::RowColumnIndex from, 
+	const type::RowColumnIndex to
+) const noexcept
 {
+	if (from._r == to._r && from._r < _num_rows) {
+		// Count along the row a word at a time.
+		const std::size_t first_col = std::min(from._c, to._c);
+		const std::size_t last_col = std::max(from._c, to._c);
+
+		if (first_col >= _num_columns) {
+			// Entirely off the right edge of the area map.
+			return last_col - first_col + 1;
+		}
+
+		// Tiles past the right edge of the area map are all non-walkable.
+		const std::size_t last_inside = std::min< std::size_t >(
+			last_col, _num_columns - 1
+		);
+		std::size_t count = last_col - last_inside;
+
+		const std::uint64_t* words = &_walkable[from._r * _walkable_words_per_row];
+
+		for (std::size_t w = first_col / 64; w <= last_inside / 64; ++w) {
+			const std::uint64_t mask = bit_range_(
+				w == first_col / 64 ? first_col % 64 : 0,
+				w == last_inside / 64 ? last_inside % 64 : 63
+			);
+
+			count += std::bitset< 64 >(~words[w] & mask).count();
+		}
+
+		return count;
+	}
+
+	// Walk the tiles along the line with Bresenham's algorithm.
+	long long r = from._r;
+	long long c = from._c;
+	const long long end_r = to._r;
+	const long long end_c = to._c;
+	const long long dr = std::abs(end_r - r);
+	const long long dc = std::abs(end_c - c);
+	const long long step_r = r < end_r ? 1 : -1;
+	const long long step_c = c < end_c ? 1 : -1;
+	long long err = dc - dr;
+	std::size_t count = 0;
+
+	while (true) {
+		if (!isAreaWalkable(r, c, 1, 1)) {
+			++count;
+		}
+
+		if (r == end_r && c == end_c) {
+			break;
+		}
+
+		const long long err2 = 2 * err;
+
+		if (err2 > -dr) {
+			err -= dr;
+			c += step_c;
+		}
+
+		if (err2 < dc) {
+			err += dc;
+			r += step_r;
+		}
+	}
+
+	return count;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
-} 
\ No newline at end of file
+}
@@ -5,24 +5,27 @@
 ////////////////////////////////////////////////////////////////////////////////
 #include "entity/Entity.hpp"
 
-#include <SFML/Graphics/Color.hpp>
-#include <algorithm>
-#include <utility>
-
 namespace nemo
 {
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
-Entity::Entity(
-	std::unique_ptr< ai::EntityAI >&&         ai,
-	std::unique_ptr< sprite::EntitySprite >&& sprite
-)
+Entity::Entity(EntityRegistry& registry, const EntityHandle handle)
+noexcept
+	: _registry(&registry)
+	, _handle(handle)
 {
-	changeAI(std::move(ai));
-	changeSprite(std::move(sprite));
-	setMovability(std::make_unique< attr::Movable >());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+EntityHandle
+Entity::handle()
+const noexcept
+{
+	return _handle;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -32,7 +35,21 @@ type::Vector2
 Entity::position()
 const noexcept
 {
-	return _position;
+	return _registry->_positions[index()];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+sf::Vector2f
+Entity::interpolatedPosition(const float alpha)
+const noexcept
+{
+	const std::size_t i = index();
+	const auto previous = _registry->_previous_positions[i].sfVector2< float >();
+	const auto current = _registry->_positions[i].sfVector2< float >();
+
+	return previous + (current - previous) * alpha;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -42,7 +59,19 @@ void
 Entity::setPosition(const type::Vector2 position)
 noexcept
 {
-	_position = position;
+	_registry->_positions[index()] = position;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+Entity::teleport(const type::Vector2 position)
+noexcept
+{
+	const std::size_t i = index();
+	_registry->_positions[i] = position;
+	_registry->_previous_positions[i] = position;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -52,35 +81,87 @@ const attr::Movement&
 Entity::movement()
 const noexcept
 {
-	return *_movement;
+	return _registry->_movements[index()];
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
 void
-Entity::setMovability(std::unique_ptr< attr::Movement >&& movement)
+Entity::setMovability(const attr::Movement& movement)
 noexcept
 {
-	_movement = std::move(movement);
+	_registry->setMovement(_handle, movement);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+attr::MovementIntent
+Entity::intent()
+const noexcept
+{
+	return _registry->_intents[index()];
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
 void
-Entity::changeAI(std::unique_ptr< ai::EntityAI >&& ai)
+Entity::setIntent(const attr::MovementIntent intent)
+noexcept
+{
+	_registry->_intents[index()] = intent;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+bool
+Entity::wanders()
+const noexcept
 {
-	_ai = std::move(ai);
+	return _registry->_wanders[index()] != 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+util::RandomStream
+Entity::random()
+const noexcept
+{
+	return _registry->randomStream(_handle);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+Entity::changeAI(ai::EntityAI& ai)
+noexcept
+{
+	_registry->_ais[index()] = &ai;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+const sprite::EntitySprite&
+Entity::sprite()
+const noexcept
+{
+	return *_registry->_sprites[index()];
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
 void
-Entity::changeSprite(std::unique_ptr< sprite::EntitySprite >&& sprite)
+Entity::changeSprite(const sprite::EntitySprite& sprite)
+noexcept
 {
-	_sprite = std::move(sprite);
+	_registry->_sprites[index()] = &sprite;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -90,17 +171,50 @@ attr::MovementSpeed
 Entity::speed()
 const noexcept
 {
-	return _speed;
+	return _registry->_speeds[index()];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+Entity::simulate()
+{
+	EntityRegistry& registry = *_registry;
+	std::size_t i = index();
+
+	registry.drawWanders(i, i + 1);
+	registry._ais[i]->commitAction(*this);
+
+	// The AI may have changed the entity's place in the registry.
+	i = index();
+	registry._previous_positions[i] = registry._positions[i];
+
+	if (i < registry._num_movable && registry._intents[i]._direction) {
+		attr::followIntent(registry._movements[i], *this, registry._intents[i]);
+	}
+
+	registry._intents[index()] = {};
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
 void
-Entity::updateObject(sf::RenderWindow& window)
+Entity::render(RenderQueue& queue, const float alpha)
+const
+{
+	_registry->_sprites[index()]->queueEntity(queue, *this, alpha);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+std::size_t
+Entity::index()
+const noexcept
 {
-	_ai->commitAction(*this);
-	_sprite->displayEntity(window, *this);
+	return _registry->indexOf(_handle);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
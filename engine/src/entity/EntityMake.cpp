@@ -20,53 +20,69 @@ namespace nemo
 
 namespace
 {
-	const auto make_entity_ = [] (
-		std::unique_ptr< ai::EntityAI >&&        ai, 
-		std::unique_ptr< sprite::EntitySprite>&& sprite)
+	/// Gets the one behaviour object of a type that all entities share.
+	template< typename T >
+	T&
+	shared_()
 	{
-		return std::make_unique< Entity >( std::move(ai), std::move(sprite));
-	};
+		static T behaviour;
+		return behaviour;
+	}
 }
 
-EntityMake::entity_ptr_t
-EntityMake::entity(const EntityID what)
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+std::optional< Entity >
+EntityMake::entity(EntityRegistry& registry, const EntityID what)
 {
 	switch (what) {
 		case EntityID::Hero:
-		return hero();
+		return hero(registry);
 		
 		case EntityID::TeenageBoy:
-		return teenageBoy();
+		return teenageBoy(registry);
 
 		default:
 		break;
 	}
 
-	return nullptr;
+	return {};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+Entity
+EntityMake::hero(EntityRegistry& registry)
+{
+	return registry.entity(registry.spawn(
+		shared_< ai::Player >(),
+		shared_< sprite::Hero >()
+	));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
-EntityMake::entity_ptr_t
-EntityMake::hero()
+Entity
+EntityMake::teenageBoy(EntityRegistry& registry)
 {
-	return make_entity_(
-		std::make_unique< ai::Player >(),
-		std::make_unique< sprite::Hero >()
-	);
+	return registry.entity(registry.spawn(
+		shared_< ai::RandomPedestrian >(),
+		shared_< sprite::TeenageBoy >()
+	));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
-EntityMake::entity_ptr_t
-EntityMake::teenageBoy()
+bool
+EntityMake::despawn(EntityRegistry& registry, const EntityHandle handle)
+noexcept
 {
-	return make_entity_(
-		std::make_unique< ai::RandomPedestrian >(),
-		std::make_unique< sprite::TeenageBoy >()
-	);
+	// Behaviours are shared, so there's nothing else to clean up.
+	return registry.despawn(handle);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,417 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \copyright MIT License                                                   ///
+/// \author    Caylen Lee                                                    ///
+/// \date      2019                                                          ///
+////////////////////////////////////////////////////////////////////////////////
+#include "entity/EntityRegistry.hpp"
+#include "entity/Entity.hpp"
+#include "entity/ai/EntityAI.hpp"
+#include "entity/sprite/EntitySprite.hpp"
+
+#include <algorithm>
+#include <utility>
+#include <variant>
+
+namespace nemo
+{
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+	/// Number of entities whose AI runs in one job. AIs are cheap, so a chunk
+	/// needs a few hundred to outweigh handing it out.
+	constexpr std::size_t ai_grain_size_ = 256;
+
+	/// Each entity's random stream advances by 2^16 numbers per tick, more
+	/// than any AI draws in one tick.
+	constexpr unsigned random_numbers_per_tick_log2_ = 16;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+bool
+EntityHandle::operator == (const EntityHandle rhs)
+const noexcept
+{
+	return _index == rhs._index && _generation == rhs._generation;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+bool
+EntityHandle::operator != (const EntityHandle rhs)
+const noexcept
+{
+	return !(*this == rhs);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+EntityRegistry::EntityRegistry() = default;
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+EntityRegistry::setWorld(const World* world)
+noexcept
+{
+	_world = world;
+
+	for (attr::Movement& movement : _movements) {
+		if (auto* movable = std::get_if< attr::Movable >(&movement)) {
+			movable->setWorld(world);
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+EntityHandle
+EntityRegistry::spawn(ai::EntityAI& ai, const sprite::EntitySprite& sprite)
+{
+	const auto index = static_cast< std::uint32_t >(_handles.size());
+	std::uint32_t slot;
+
+	if (_free_slots.empty()) {
+		slot = static_cast< std::uint32_t >(_slot_indices.size());
+		_slot_indices.push_back(index);
+		_slot_generations.push_back(0);
+	}
+	else {
+		// Reuse the slot of a despawned entity.
+		slot = _free_slots.back();
+		_free_slots.pop_back();
+		_slot_indices[slot] = index;
+	}
+
+	const EntityHandle handle = { slot, _slot_generations[slot] };
+	_handles.push_back(handle);
+	_positions.emplace_back();
+	_previous_positions.emplace_back();
+	_speeds.emplace_back();
+	_intents.emplace_back();
+	_movements.emplace_back(
+		_world ? attr::Movable(*_world) : attr::Movable()
+	);
+	_ais.push_back(&ai);
+	_sprites.push_back(&sprite);
+	_stream_ids.push_back(streamId(handle));
+	_wanders.push_back(0);
+
+	// New entities can move, so they go at the end of the movable part.
+	swapEntities(index, _num_movable);
+	++_num_movable;
+
+	return handle;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+bool
+EntityRegistry::despawn(const EntityHandle handle)
+noexcept
+{
+	if (!contains(handle)) {
+		return false;
+	}
+
+	std::size_t index = indexOf(handle);
+
+	// Fill the hole in the movable part with its last entity, so the hole is
+	// at the boundary with the immovable part.
+	if (index < _num_movable) {
+		--_num_movable;
+		swapEntities(index, _num_movable);
+		index = _num_movable;
+	}
+
+	// Fill the hole with the last entity to keep the pools contiguous.
+	swapEntities(index, _handles.size() - 1);
+
+	_handles.pop_back();
+	_positions.pop_back();
+	_previous_positions.pop_back();
+	_speeds.pop_back();
+	_intents.pop_back();
+	_movements.pop_back();
+	_ais.pop_back();
+	_sprites.pop_back();
+	_stream_ids.pop_back();
+	_wanders.pop_back();
+
+	// Invalidate existing handles to the entity before its slot is reused.
+	++_slot_generations[handle._index];
+	_free_slots.push_back(handle._index);
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+bool
+EntityRegistry::contains(const EntityHandle handle)
+const noexcept
+{
+	return handle._index < _slot_generations.size() &&
+		_slot_generations[handle._index] == handle._generation;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+Entity
+EntityRegistry::entity(const EntityHandle handle)
+noexcept
+{
+	return Entity(*this, handle);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+Entity
+EntityRegistry::at(const std::size_t i)
+noexcept
+{
+	return Entity(*this, _handles[i]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+std::size_t
+EntityRegistry::size()
+const noexcept
+{
+	return _handles.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+EntityRegistry::reserve(const std::size_t capacity)
+{
+	_slot_indices.reserve(capacity);
+	_slot_generations.reserve(capacity);
+	_handles.reserve(capacity);
+	_positions.reserve(capacity);
+	_previous_positions.reserve(capacity);
+	_speeds.reserve(capacity);
+	_intents.reserve(capacity);
+	_movements.reserve(capacity);
+	_ais.reserve(capacity);
+	_sprites.reserve(capacity);
+	_stream_ids.reserve(capacity);
+	_wanders.reserve(capacity);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+EntityRegistry::seed(const std::uint64_t seed)
+noexcept
+{
+	_random.reseed(seed);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+std::uint64_t
+EntityRegistry::seed()
+const noexcept
+{
+	return _random.seed();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+EntityRegistry::runAI()
+{
+	drawWanders(0, _handles.size());
+
+	for (std::size_t i = 0; i < _handles.size(); ++i) {
+		Entity entity(*this, _handles[i]);
+		_ais[i]->commitAction(entity);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+EntityRegistry::runAI(util::JobSystem& jobs)
+{
+	jobs.parallelFor(_handles.size(), ai_grain_size_,
+		[this] (const std::size_t begin, const std::size_t end) {
+			drawWanders(begin, end);
+
+			for (std::size_t i = begin; i < end; ++i) {
+				Entity entity(*this, _handles[i]);
+				_ais[i]->commitAction(entity);
+			}
+		}
+	);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+EntityRegistry::applyMovement()
+noexcept
+{
+	// Immovable entities never change position, so their previous positions
+	// are already their current ones.
+	std::copy_n(_positions.cbegin(), _num_movable, _previous_positions.begin());
+
+	for (std::size_t i = 0; i < _num_movable; ++i) {
+		if (_intents[i]._direction) {
+			Entity entity(*this, _handles[i]);
+			attr::followIntent(_movements[i], entity, _intents[i]);
+		}
+
+		_intents[i] = {};
+	}
+
+	++_tick;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+EntityRegistry::render(RenderQueue& queue, const float alpha)
+{
+	for (std::size_t i = 0; i < _handles.size(); ++i) {
+		const Entity entity(*this, _handles[i]);
+		_sprites[i]->queueEntity(queue, entity, alpha);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+std::size_t
+EntityRegistry::indexOf(const EntityHandle handle)
+const noexcept
+{
+	return _slot_indices[handle._index];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+EntityRegistry::setMovement(
+	const EntityHandle      handle, 
+	const attr::Movement&   movement
+) noexcept
+{
+	const std::size_t index = indexOf(handle);
+	const bool could_move = index < _num_movable;
+	const bool can_move = attr::canMove(movement);
+
+	_movements[index] = movement;
+
+	if (could_move && !can_move) {
+		// Stop drawing it moving towards where it was last moved to.
+		_previous_positions[index] = _positions[index];
+
+		--_num_movable;
+		swapEntities(index, _num_movable);
+	}
+	else if (!could_move && can_move) {
+		// Don't act on an intent left over from while it couldn't move.
+		_intents[index] = {};
+
+		swapEntities(index, _num_movable);
+		++_num_movable;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+EntityRegistry::swapEntities(const std::size_t a, const std::size_t b)
+noexcept
+{
+	if (a == b) {
+		return;
+	}
+
+	using std::swap;
+	swap(_handles[a],            _handles[b]);
+	swap(_positions[a],          _positions[b]);
+	swap(_previous_positions[a], _previous_positions[b]);
+	swap(_speeds[a],             _speeds[b]);
+	swap(_intents[a],            _intents[b]);
+	swap(_movements[a],          _movements[b]);
+	swap(_ais[a],                _ais[b]);
+	swap(_sprites[a],            _sprites[b]);
+	swap(_stream_ids[a],         _stream_ids[b]);
+	swap(_wanders[a],            _wanders[b]);
+
+	_slot_indices[_handles[a]._index] = static_cast< std::uint32_t >(a);
+	_slot_indices[_handles[b]._index] = static_cast< std::uint32_t >(b);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+EntityRegistry::drawWanders(const std::size_t begin, const std::size_t end)
+noexcept
+{
+	// Same draw as the first number of each entity's stream for this tick.
+	_random.chances(
+		_stream_ids.data() + begin, end - begin, 
+		_tick << random_numbers_per_tick_log2_, 
+		attr::_wander_chance._numerator, attr::_wander_chance._denominator, 
+		_wanders.data() + begin
+	);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+std::uint64_t
+EntityRegistry::streamId(const EntityHandle handle)
+noexcept
+{
+	// A respawned entity gets a new stream, not the one of its slot's last 
+	// entity.
+	return (static_cast< std::uint64_t >(handle._index) << 32) | 
+		handle._generation;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+util::RandomStream
+EntityRegistry::randomStream(const EntityHandle handle)
+const noexcept
+{
+	// The tick's first number was already drawn by drawWanders.
+	return _random.stream(
+		streamId(handle), (_tick << random_numbers_per_tick_log2_) + 1
+	);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+}
@@ -30,107 +30,188 @@ namespace
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+Movable::Movable()
+noexcept
+	: _world(nullptr)
+	, _hitbox(
+		type::x_t(constants::_tile_side_length), 
+		type::y_t(constants::_tile_side_length)
+	)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+Movable::Movable(const World& world, const type::Vector2 hitbox)
+noexcept
+	: _world(&world)
+	, _hitbox(hitbox)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 void
-Movable::moveLeft(Entity& entity, const int speed)
+Movable::setWorld(const World* world)
+noexcept
+{
+	_world = world;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+World::SweepResult
+Movable::followIntent(Entity& entity, const MovementIntent intent)
 const noexcept
 {
-	type::Vector2 position = entity.position();
-	position._x -= type::x_t(speed);
-	entity.setPosition(position);
+	if (!intent._direction) {
+		// Standing still.
+		return { type::Vector2(), false, std::nullopt };
+	}
+
+	switch (*intent._direction) {
+		case Direction::Left:  return moveLeft(entity, intent._speed);
+		case Direction::Up:    return moveUp(entity, intent._speed);
+		case Direction::Right: return moveRight(entity, intent._speed);
+		case Direction::Down:  return moveDown(entity, intent._speed);
+		
+		default:
+		break;
+	}
+
+	return { type::Vector2(), false, std::nullopt };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+World::SweepResult
+Movable::move(Entity& entity, const type::Vector2 displacement)
+const noexcept
+{
+	const type::Vector2 position = entity.position();
+
+	const World::SweepResult result = _world
+		? _world->sweepBox(position, _hitbox, displacement)
+		: World::SweepResult{ displacement, false, std::nullopt };
 
+	entity.setPosition(position + result._displacement);
+	return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+World::SweepResult
+Movable::moveLeft(Entity& entity, const int speed)
+const noexcept
+{
+	const auto result = move(entity, { type::x_t(-speed), type::y_t(0) });
 	log_movement_(entity, speed, "left");
+	return result;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
-void
+World::SweepResult
 Movable::moveUp(Entity& entity, const int speed)
 const noexcept
 {
-	type::Vector2 position = entity.position();
-
 	// Y = 0 is at the top of the window screen instead of the bottom, so 
 	// subtract from the current y-cooordinate to move up.
-	position._y -= type::y_t(speed);
-	entity.setPosition(position);
-
+	const auto result = move(entity, { type::x_t(0), type::y_t(-speed) });
 	log_movement_(entity, speed, "up");
+	return result;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
-void
+World::SweepResult
 Movable::moveRight(Entity& entity, const int speed)
 const noexcept
 {
-	type::Vector2 position = entity.position();
-	position._x += type::x_t(speed);
-	entity.setPosition(position);
-
+	const auto result = move(entity, { type::x_t(speed), type::y_t(0) });
 	log_movement_(entity, speed, "right");
+	return result;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
-void
+World::SweepResult
 Movable::moveDown(Entity& entity, const int speed)
 const noexcept
 {
-	type::Vector2 position = entity.position();
-
 	// Y = 0 is at the top of the window screen instead of the bottom, so add 
 	// to the current y-cooordinate to move down.
-	position._y += type::y_t(speed);
-	entity.setPosition(position);
-
+	const auto result = move(entity, { type::x_t(0), type::y_t(speed) });
 	log_movement_(entity, speed, "down");
+	return result;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
-void
+World::SweepResult
+Immovable::followIntent(
+	[[maybe_unused]] Entity&              entity, 
+	[[maybe_unused]] const MovementIntent intent
+) const noexcept
+{
+	return { type::Vector2(), false, std::nullopt };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+World::SweepResult
 Immovable::moveLeft(
 	[[maybe_unused]] Entity&   entity, 
 	[[maybe_unused]] const int speed
 ) const noexcept
 {
+	return { type::Vector2(), false, std::nullopt };
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
-void
+World::SweepResult
 Immovable::moveUp(
 	[[maybe_unused]] Entity&   entity, 
 	[[maybe_unused]] const int speed
 ) const noexcept
 {
+	return { type::Vector2(), false, std::nullopt };
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
-void
+World::SweepResult
 Immovable::moveRight(
 	[[maybe_unused]] Entity&   entity, 
 	[[maybe_unused]] const int speed
 ) const noexcept
 {
+	return { type::Vector2(), false, std::nullopt };
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
-void
+World::SweepResult
 Immovable::moveDown(
 	[[maybe_unused]] Entity&   entity, 
 	[[maybe_unused]] const int speed
 ) const noexcept
 {
+	return { type::Vector2(), false, std::nullopt };
 }
 
 ////////////////////////////////////////////////////////////////////////////////
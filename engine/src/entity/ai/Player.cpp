@@ -4,7 +4,7 @@
 /// \date      2019                                                          ///
 ////////////////////////////////////////////////////////////////////////////////
 #include "entity/ai/Player.hpp"
-#include "entity/Movement.hpp"
+#include "entity/attributes.hpp"
 #include "entity/Entity.hpp"
 
 namespace nemo::ai
@@ -25,17 +25,28 @@ void
 Player::commitAction(Entity& entity)
 {
 	if (const auto direction = _controller->pressedDirection(); direction) {
-		const attr::Movement& movement = entity.movement();
-
-		const int speed = _controller->pressedButton({Button::Cancel}).has_value()
+		constexpr auto run = Controller::mask({ Button::Cancel });
+		const int speed = _controller->pressedButton(run).has_value()
 			? entity.speed()._running
 			: entity.speed()._walking;
 
+		// Movement is carried out later, in the movement phase.
 		switch (*direction) {
-			case Button::Left:  movement.moveLeft(entity, speed);  break;
-			case Button::Up:    movement.moveUp(entity, speed);    break;
-			case Button::Right: movement.moveRight(entity, speed); break;
-			case Button::Down:  movement.moveDown(entity, speed);  break;
+			case Button::Left:  
+			entity.setIntent({ attr::Direction::Left, speed });
+			break;
+
+			case Button::Up:    
+			entity.setIntent({ attr::Direction::Up, speed });
+			break;
+
+			case Button::Right: 
+			entity.setIntent({ attr::Direction::Right, speed });
+			break;
+
+			case Button::Down:  
+			entity.setIntent({ attr::Direction::Down, speed });
+			break;
 			
 			default:
 			break;
@@ -5,10 +5,9 @@
 ////////////////////////////////////////////////////////////////////////////////
 #include "entity/ai/RandomPedestrian.hpp"
 #include "entity/Entity.hpp"
-#include "entity/Movement.hpp"
+#include "entity/attributes.hpp"
 
 #include <array>
-#include <functional>
 
 namespace nemo::ai
 {
@@ -16,10 +15,15 @@ namespace nemo::ai
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
-namespace 
+namespace
 {
-	/// Random number generator for deciding pedestrian's actions.
-	std::mt19937 rng_((std::random_device())());
+	/// Directions a pedestrian can wander in, picked from by index.
+	constexpr std::array directions_ = {
+		attr::Direction::Left,
+		attr::Direction::Up,
+		attr::Direction::Right,
+		attr::Direction::Down
+	};
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -28,49 +32,33 @@ namespace
 void
 RandomPedestrian::commitAction(Entity& entity)
 {
-	if (!timeToMove()) {
+	// Whether to move was drawn for every entity at once at the start of the 
+	// AI phase.
+	if (!entity.wanders()) {
 		return;
 	}
 
-	goRandomDirection(entity);
-}
-
-////////////////////////////////////////////////////////////////////////////////
-////////////////////////////////////////////////////////////////////////////////
-
-bool
-RandomPedestrian::timeToMove()
-const noexcept
-{
-	// Entity would stand still for roughly 80% of the time and walk for the 
-	// other 20%.
-	constexpr auto odds_of_standing = 8;
-	constexpr auto odds_of_moving = 2;
-	std::uniform_int_distribution distrib(1, odds_of_standing + odds_of_moving);
-	
-	return distrib(rng_) <= odds_of_moving;
+	// Draw from the entity's own stream, so its actions only depend on the 
+	// seed and the tick, not on which thread runs it.
+	util::RandomStream rng = entity.random();
+	goRandomDirection(entity, rng);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
 void
-RandomPedestrian::goRandomDirection(Entity& entity)
-const noexcept
+RandomPedestrian::goRandomDirection(
+	Entity&             entity, 
+	util::RandomStream& rng
+) const noexcept
 {
-	const int speed = entity.speed()._walking;
-	const attr::Movement& movement = entity.movement();
-	constexpr auto num_directions = 4;	
-	 
-	const auto movers = std::array< std::function<void()>, num_directions > ({
-		[&entity, &movement, speed] () { movement.moveLeft(entity, speed);  },
-		[&entity, &movement, speed] () { movement.moveUp(entity, speed);    },
-		[&entity, &movement, speed] () { movement.moveRight(entity, speed); },
-		[&entity, &movement, speed] () { movement.moveDown(entity, speed);  }
-	});
+	constexpr auto num_directions = 
+		static_cast< std::uint32_t >(directions_.size());
 
-	std::uniform_int_distribution<unsigned> distrib(0, num_directions - 1);
-	// movers[distrib(_rng)]();
+	entity.setIntent({ 
+		directions_[rng.nextBelow(num_directions)], entity.speed()._walking
+	});
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -7,7 +7,6 @@
 #include "entity/Entity.hpp"
 #include "constants.hpp"
 
-#include <SFML/Graphics/RectangleShape.hpp>
 #include <SFML/Graphics/Color.hpp>
 
 namespace nemo::sprite
@@ -17,19 +16,23 @@ namespace nemo::sprite
 ////////////////////////////////////////////////////////////////////////////////
 
 void
-TeenageBoy::displayEntity(sf::RenderWindow& window, const Entity& entity)
-const
+TeenageBoy::queueEntity(
+	RenderQueue&      queue, 
+	const Entity&     entity, 
+	const float       alpha
+) const
 {
-	const type::Vector2 position = entity.position();
-	
-	sf::RectangleShape graphics;
-	graphics.setPosition(position.sfVector2< float >());
-	graphics.setFillColor(sf::Color::Red);
-	graphics.setSize({ 
-		constants::_tile_side_length, constants::_tile_side_length
+	constexpr auto length = static_cast< float >(constants::_tile_side_length);
+	const sf::Vector2f position = entity.interpolatedPosition(alpha);
+
+	// Entities further down the screen are drawn over those above them.
+	queue.push({
+		nullptr,
+		position.y + length,
+		sf::FloatRect(position, { length, length }),
+		sf::IntRect(),
+		sf::Color::Red
 	});
-	
-	window.draw(graphics);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1,61 +1,183 @@
 #include "Game.hpp"
 #include "Controller.hpp"
+#include "InputPump.hpp"
+#include "InputRecording.hpp"
+#include "TextureCache.hpp"
+#include "constants.hpp"
+#include "util/logger.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <vector>
 
 #include <SFML/Graphics/RenderWindow.hpp>
 #include <SFML/Window/Event.hpp>
 #include <SFML/Window/VideoMode.hpp>
 
+namespace
+{
+	/**
+	 * \brief
+	 * Shuts the logger down when main returns, however it returns.
+	 */
+	struct LoggerGuard_
+	{
+		~LoggerGuard_()
+		{
+			nemo::util::shutdownLogger();
+		}
+	};
+
+	/**
+	 * \brief
+	 * Runs the game on recorded input as fast as possible, without a window,
+	 * and prints how long the ticks took.
+	 *
+	 * \param file
+	 * Input recording.
+	 *
+	 * \return
+	 * Exit code.
+	 */
+	int
+	replay_(const char* file)
+	{
+		using clock = std::chrono::steady_clock;
+		using std::chrono::duration;
+		using std::chrono::nanoseconds;
+
+		nemo::InputReplay replay(file);
+
+		if (replay.numTicks() == 0) {
+			std::cerr << "Nothing to replay in " << file << '\n';
+			return EXIT_FAILURE;
+		}
+
+		nemo::Game& game = nemo::Game::getInstance();
+		game.setTickRate(replay.tickRate());
+		game.entities().seed(replay.seed());
+
+		nanoseconds total(0);
+		nanoseconds slowest(0);
+
+		while (replay.replayTick()) {
+			const auto start = clock::now();
+			game.tick();
+
+			const nanoseconds elapsed = clock::now() - start;
+			total += elapsed;
+			slowest = std::max(slowest, elapsed);
+		}
+
+		using ms = duration< double, std::milli >;
+		std::cout
+			<< "Replayed " << replay.numTicks() << " ticks in "
+			<< ms(total).count() << " ms (mean "
+			<< ms(total).count() / replay.numTicks() << " ms, max "
+			<< ms(slowest).count() << " ms per tick)\n";
+
+		return EXIT_SUCCESS;
+	}
+}
+
+/**
+ * \brief
+ * Usage:
+ * \code
+ * 	nemo [--record <file> | --replay <file>]
+ * \endcode
+ *
+ * --record saves the player's input on every tick to a file while playing.
+ * --replay runs the game on input saved with --record, with no window, and
+ * prints tick timings to compare performance across builds.
+ */
 int
-main()
+main(int argc, char* argv[])
 {
+	// Declared first, so it runs after everything else in main is destroyed.
+	LoggerGuard_ logger_guard;
+	std::unique_ptr< nemo::InputRecorder > recorder;
+
+	if (argc == 3 && std::strcmp(argv[1], "--replay") == 0) {
+		return replay_(argv[2]);
+	}
+	else if (argc == 3 && std::strcmp(argv[1], "--record") == 0) {
+		recorder = std::make_unique< nemo::InputRecorder >(
+			argv[2], nemo::constants::_tick_rate, 
+			nemo::Game::getInstance().entities().seed()
+		);
+
+		if (!recorder->isRecording()) {
+			return EXIT_FAILURE;
+		}
+
+		nemo::Game::getInstance().setRecorder(recorder.get());
+	}
+	else if (argc != 1) {
+		std::cerr << "Usage: nemo [--record <file> | --replay <file>]\n";
+		return EXIT_FAILURE;
+	}
+
 	// Open a window for the game.
-	sf::RenderWindow window(sf::VideoMode(1280, 720), "Nemo");
-	window.setFramerateLimit(30);
+	sf::RenderWindow window(
+		sf::VideoMode(
+			nemo::constants::_window_width, nemo::constants::_window_height
+		), 
+		"Nemo"
+	);
+	window.setVerticalSyncEnabled(true);
 	window.setKeyRepeatEnabled(false);
 
+	// The game simulates at a fixed rate no matter how fast frames are drawn.
+	using clock = std::chrono::steady_clock;
+	auto last_frame = clock::now();
+	nemo::InputPump input;
+
 	// Run the game for as long as its window is open.
 	while (window.isOpen()) {
-		// Update game.
 		nemo::Game& game = nemo::Game::getInstance();
-		window.clear();
-		game.updateFrame(window);
-		window.display();
-		
-		// Get whatever event happened.
-		sf::Event event;
 
-		if (!window.pollEvent(event)) {
-			// No pending events.
-			continue;
-		}
-		
-		switch (event.type) {
-			case sf::Event::Closed:
-			window.close();
-			break;
-			
-			case sf::Event::LostFocus:
-			game.pause();
-			break;
-
-			case sf::Event::GainedFocus:
-			game.resume();
-			break;
-
-			case sf::Event::KeyPressed:
-			nemo::Controller::registerKeyPress(event.key.code);
-			break;
-
-			case sf::Event::KeyReleased:
-			nemo::Controller::registerKeyRelease(event.key.code);
-			break;
-
-			default:
-			break;
+		// Handle every event that happened since the last frame before 
+		// updating the game, so input is never more than a frame late.
+		const std::vector< nemo::InputEvent >& events = input.drain(window);
+		nemo::Controller::registerKeyEvents(events);
+
+		for (const nemo::InputEvent& e : events) {
+			switch (e._event.type) {
+				case sf::Event::Closed:
+				window.close();
+				break;
+				
+				case sf::Event::LostFocus:
+				game.pause();
+				break;
+
+				case sf::Event::GainedFocus:
+				game.resume();
+				break;
+
+				default:
+				break;
+			}
 		}
+
+		// Update game.
+		const auto this_frame = clock::now();
+		window.clear();
+		game.updateFrame(window, this_frame - last_frame);
+		window.display();
+		last_frame = this_frame;
 	}
 
+	nemo::Game::getInstance().setRecorder(nullptr);
+
+	// The game and the texture cache are statics, so release their textures 
+	// now rather than at exit, when SFML's graphics context may be gone.
+	nemo::Game::getInstance().releaseTextures();
+	nemo::TextureCache::getInstance().clear();
 	return EXIT_SUCCESS;
 }
\ No newline at end of file
@@ -0,0 +1,184 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \copyright MIT License                                                   ///
+/// \author    Caylen Lee                                                    ///
+/// \date      2019                                                          ///
+////////////////////////////////////////////////////////////////////////////////
+#include "util/JobSystem.hpp"
+
+#include <algorithm>
+
+namespace nemo::util
+{
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+JobSystem::JobSystem(const unsigned num_workers)
+	: _queues(std::make_unique< Queue[] >(std::max(num_workers, 1u)))
+	, _num_workers(std::max(num_workers, 1u))
+	, _body(nullptr)
+	, _num_remaining(0)
+	, _generation(0)
+	, _is_stopping(false)
+{
+	_threads.reserve(_num_workers - 1);
+
+	for (unsigned w = 1; w < _num_workers; ++w) {
+		_threads.emplace_back(&JobSystem::work, this, w);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard lock(_mutex);
+		_is_stopping = true;
+	}
+
+	_wake.notify_all();
+
+	for (std::thread& thread : _threads) {
+		thread.join();
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned
+JobSystem::numWorkers()
+const noexcept
+{
+	return _num_workers;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+JobSystem::parallelFor(
+	const std::size_t count,
+	const std::size_t grain,
+	const body_t&     body
+)
+{
+	const std::size_t chunk_size = std::max< std::size_t >(grain, 1);
+
+	if (_threads.empty() || count <= chunk_size) {
+		// Not worth waking the workers for.
+		body(0, count);
+		return;
+	}
+
+	const std::size_t num_chunks = (count + chunk_size - 1) / chunk_size;
+	_num_remaining = num_chunks;
+
+	{
+		std::lock_guard lock(_mutex);
+		_body = &body;
+	}
+
+	// Deal the chunks out evenly, so workers only steal once they run out.
+	for (std::size_t i = 0; i < num_chunks; ++i) {
+		Queue& queue = _queues[i % _num_workers];
+		std::lock_guard lock(queue._mutex);
+		queue._chunks.push_back({
+			i * chunk_size, std::min(count, (i + 1) * chunk_size)
+		});
+	}
+
+	{
+		std::lock_guard lock(_mutex);
+		++_generation;
+	}
+
+	_wake.notify_all();
+	runChunks(0);
+
+	std::unique_lock lock(_mutex);
+	_done.wait(lock, [this] { return _num_remaining == 0; });
+	_body = nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+JobSystem::work(const unsigned worker)
+{
+	std::size_t generation = 0;
+
+	while (true) {
+		{
+			std::unique_lock lock(_mutex);
+			_wake.wait(lock, [this, generation] {
+				return _is_stopping || _generation != generation;
+			});
+
+			if (_is_stopping) {
+				return;
+			}
+
+			generation = _generation;
+		}
+
+		runChunks(worker);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+JobSystem::runChunks(const unsigned worker)
+{
+	while (const std::optional< Chunk > chunk = nextChunk(worker)) {
+		// The body was set before any chunk was queued.
+		(*_body)(chunk->_begin, chunk->_end);
+
+		if (--_num_remaining == 0) {
+			std::lock_guard lock(_mutex);
+			_done.notify_all();
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+std::optional< JobSystem::Chunk >
+JobSystem::nextChunk(const unsigned worker)
+{
+	for (unsigned i = 0; i < _num_workers; ++i) {
+		// Own queue first, then the others', starting from the next worker's.
+		Queue& queue = _queues[(worker + i) % _num_workers];
+		std::lock_guard lock(queue._mutex);
+
+		if (queue._chunks.empty()) {
+			continue;
+		}
+
+		Chunk chunk;
+
+		if (i == 0) {
+			chunk = queue._chunks.front();
+			queue._chunks.pop_front();
+		}
+		else {
+			chunk = queue._chunks.back();
+			queue._chunks.pop_back();
+		}
+
+		return chunk;
+	}
+
+	return {};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+}
@@ -0,0 +1,146 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \copyright MIT License                                                   ///
+/// \author    Caylen Lee                                                    ///
+/// \date      2019                                                          ///
+////////////////////////////////////////////////////////////////////////////////
+#include "util/Random.hpp"
+
+namespace nemo::util
+{
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+RandomStream::RandomStream(const std::uint64_t key, const std::uint64_t counter)
+noexcept
+	: _key(key)
+	, _counter(counter)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+std::uint64_t
+RandomStream::next()
+noexcept
+{
+	return at(_key, _counter++);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+std::uint32_t
+RandomStream::nextBelow(const std::uint32_t bound)
+noexcept
+{
+	return below(next(), bound);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+bool
+RandomStream::nextChance(
+	const std::uint32_t numerator,
+	const std::uint32_t denominator
+) noexcept
+{
+	return nextBelow(denominator) < numerator;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+RandomStream::skip(const std::uint64_t n)
+noexcept
+{
+	_counter += n;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+std::uint64_t
+RandomStream::counter()
+const noexcept
+{
+	return _counter;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+Random::Random(const std::uint64_t seed)
+noexcept
+	: _seed(seed)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+Random::reseed(const std::uint64_t seed)
+noexcept
+{
+	_seed = seed;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+std::uint64_t
+Random::seed()
+const noexcept
+{
+	return _seed;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+RandomStream
+Random::stream(const std::uint64_t id, const std::uint64_t counter)
+const noexcept
+{
+	return RandomStream(key(id), counter);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+Random::chances(
+	const std::uint64_t* ids,
+	const std::size_t    n,
+	const std::uint64_t  counter,
+	const std::uint32_t  numerator,
+	const std::uint32_t  denominator,
+	std::uint8_t*        results
+) const noexcept
+{
+	for (std::size_t i = 0; i < n; ++i) {
+		const std::uint64_t value = RandomStream::at(key(ids[i]), counter);
+		results[i] = RandomStream::below(value, denominator) < numerator;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+std::uint64_t
+Random::key(const std::uint64_t id)
+const noexcept
+{
+	// Hashing the identifier keeps streams with adjacent identifiers from
+	// overlapping.
+	return RandomStream::at(_seed, id);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+}
@@ -6,6 +6,7 @@
 #include "util/logger.hpp"
 #include "constants.hpp"
 
+#include <spdlog/async.h>
 #include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 
@@ -17,7 +18,34 @@ namespace nemo::util
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
-std::shared_ptr< spdlog::logger >
+namespace
+{
+	/// Configurations of the global logger, read when it's created.
+	LoggerConfig config_;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+configureLogger(const LoggerConfig& config)
+{
+	config_ = config;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+shutdownLogger()
+{
+	spdlog::shutdown();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+const std::shared_ptr< spdlog::logger >&
 logger()
 {
 	static auto init_global_logger = [] () {
@@ -33,13 +61,38 @@ logger()
 		file_sink->set_level(spdlog::level::trace);
 
 		// Logger to print to both sinks.
-		spdlog::logger logger("nemo", {console_sink, file_sink});
-		logger.set_level(spdlog::level::trace);
+		const spdlog::sinks_init_list sinks = { console_sink, file_sink };
+		std::shared_ptr< spdlog::logger > logger;
+
+		if (config_._is_async) {
+			// One background thread writes to the sinks, so the order of 
+			// messages is kept.
+			spdlog::init_thread_pool(config_._queue_size, 1);
+
+			const auto policy = config_._overflow == LogOverflow::Block
+				? spdlog::async_overflow_policy::block
+				: spdlog::async_overflow_policy::overrun_oldest;
+
+			logger = std::make_shared< spdlog::async_logger >(
+				"nemo", sinks, spdlog::thread_pool(), policy
+			);
+		}
+		else {
+			logger = std::make_shared< spdlog::logger >("nemo", sinks);
+		}
+
+		logger->set_level(spdlog::level::trace);
+		logger->flush_on(spdlog::level::err);
+
+		// Registered so spdlog's flusher thread periodically flushes it.
+		spdlog::register_logger(logger);
+		spdlog::flush_every(config_._flush_interval);
 		return logger;
 	};
 
-	// Make logger a singleton.
-	static auto logger = std::make_shared< spdlog::logger >(init_global_logger());
+	// Make logger a singleton. Returned by reference so logging doesn't touch
+	// its reference count.
+	static const auto logger = init_global_logger();
 	return logger;
 }
 
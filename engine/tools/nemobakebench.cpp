@@ -0,0 +1,223 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \copyright MIT License                                                   ///
+/// \author    Caylen Lee                                                    ///
+/// \date      2019                                                          ///
+////////////////////////////////////////////////////////////////////////////////
+#include "World/World.hpp"
+#include "World/Tileset.hpp"
+#include "World/Tile.hpp"
+#include "type/RowColumnIndex.hpp"
+#include "constants.hpp"
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+	/// Number of vertices that make up one tile sprite.
+	constexpr std::size_t vertices_per_quad_ = 4;
+
+	/**
+	 * \brief
+	 * Bakes a tile's layers with \link nemo::Tileset::writeQuads.
+	 *
+	 * \param tileset     Tileset the tile sprites come from.
+	 * \param tile        Tile to bake.
+	 * \param top_left    Top-left corner of the tile on screen.
+	 * \param vertices    Vertices to append to.
+	 */
+	void
+	bakeQuads_(
+		const nemo::Tileset&       tileset,
+		const nemo::Tile&          tile,
+		const sf::Vector2f         top_left,
+		std::vector< sf::Vertex >& vertices
+	)
+	{
+		constexpr auto length =
+			static_cast< float >(nemo::constants::_tile_side_length);
+		const std::size_t offset = vertices.size();
+		vertices.resize(offset + tile.numLayers() * vertices_per_quad_);
+
+		const std::size_t num_quads = tileset.writeQuads(
+			tile.layers(), tile.numLayers(), top_left, length, &vertices[offset]
+		);
+
+		vertices.resize(offset + num_quads * vertices_per_quad_);
+	}
+
+	/**
+	 * \brief
+	 * Bakes a tile's layers by building a sprite per layer and reading its
+	 * texture rectangle, the way tiles were baked before writeQuads.
+	 *
+	 * \param tileset     Tileset the tile sprites come from.
+	 * \param tile        Tile to bake.
+	 * \param top_left    Top-left corner of the tile on screen.
+	 * \param vertices    Vertices to append to.
+	 */
+	void
+	bakeSprites_(
+		const nemo::Tileset&       tileset,
+		const nemo::Tile&          tile,
+		const sf::Vector2f         top_left,
+		std::vector< sf::Vertex >& vertices
+	)
+	{
+		constexpr auto length =
+			static_cast< float >(nemo::constants::_tile_side_length);
+		const sf::Vector2f bottom_right = top_left + sf::Vector2f(length, length);
+
+		for (std::size_t i = 0; i < tile.numLayers(); ++i) {
+			const sf::Sprite sprite = tileset.getTileSprite(
+				nemo::Tile::unpackIndex(tile.layers()[i])
+			);
+
+			const sf::FloatRect rect(sprite.getTextureRect());
+			const float right = rect.left + rect.width;
+			const float bottom = rect.top + rect.height;
+
+			vertices.emplace_back(top_left, sf::Vector2f(rect.left, rect.top));
+			vertices.emplace_back(
+				sf::Vector2f(bottom_right.x, top_left.y),
+				sf::Vector2f(right, rect.top)
+			);
+			vertices.emplace_back(bottom_right, sf::Vector2f(right, bottom));
+			vertices.emplace_back(
+				sf::Vector2f(top_left.x, bottom_right.y),
+				sf::Vector2f(rect.left, bottom)
+			);
+		}
+	}
+
+	/// Bakes one tile; see \link bakeQuads_ and \link bakeSprites_.
+	using bake_t = std::function< void(
+		const nemo::Tileset&, const nemo::Tile&, const sf::Vector2f,
+		std::vector< sf::Vertex >&
+	) >;
+
+	/**
+	 * \brief
+	 * Bakes every tile of an area map a number of times and times it.
+	 *
+	 * \param world         Area map to bake.
+	 * \param tileset       Tileset the tile sprites come from.
+	 * \param num_passes    Number of times to bake the whole area map.
+	 * \param bake          Bakes one tile.
+	 * \param vertices      Vertices to bake into, cleared every pass.
+	 *
+	 * \return
+	 * Average time per tile, in nanoseconds.
+	 */
+	double
+	timeBake_(
+		const nemo::World&         world,
+		const nemo::Tileset&       tileset,
+		const unsigned long        num_passes,
+		const bake_t&              bake,
+		std::vector< sf::Vertex >& vertices
+	)
+	{
+		constexpr auto length =
+			static_cast< float >(nemo::constants::_tile_side_length);
+		const nemo::type::RowColumnIndex size = world.size();
+
+		using clock = std::chrono::steady_clock;
+		const auto start = clock::now();
+
+		for (unsigned long pass = 0; pass < num_passes; ++pass) {
+			vertices.clear();
+
+			for (unsigned r = 0; r < size._r; ++r) {
+				for (unsigned c = 0; c < size._c; ++c) {
+					const nemo::type::RowColumnIndex world_index = {
+						nemo::type::row_t(r), nemo::type::column_t(c)
+					};
+
+					bake(
+						tileset, world.getTile(world_index),
+						world_index.sfVector2< float >() * length, vertices
+					);
+				}
+			}
+		}
+
+		const std::chrono::duration< double, std::nano > elapsed =
+			clock::now() - start;
+
+		return elapsed.count() /
+			(double(num_passes) * double(size._r) * double(size._c));
+	}
+}
+
+/**
+ * \brief
+ * Compares the time to bake an area map's tiles into vertices with
+ * \link nemo::Tileset::writeQuads against building a sprite per layer.
+ *
+ * Usage:
+ * \code
+ * 	nemobakebench <world> [<passes>]
+ * \endcode
+ *
+ * Every tile of the area map is baked the given number of times each way, 10
+ * by default, and the average time per tile is printed. Nothing is drawn.
+ */
+int
+main(int argc, char* argv[])
+{
+	unsigned long num_passes = 10;
+
+	try {
+		if (argc == 3) {
+			num_passes = std::stoul(argv[2]);
+		}
+	}
+	catch (const std::exception&) {
+		num_passes = 0;
+	}
+
+	if (argc < 2 || argc > 3 || num_passes == 0) {
+		std::cerr << "Usage: nemobakebench <world> [<passes>]\n";
+		return EXIT_FAILURE;
+	}
+
+	const nemo::World world(argv[1]);
+	const nemo::Tileset* tileset = world.tileset();
+
+	if (!tileset) {
+		std::cerr << "Area map " << argv[1] << " has no tileset to bake\n";
+		return EXIT_FAILURE;
+	}
+
+	std::vector< sf::Vertex > quad_vertices;
+	std::vector< sf::Vertex > sprite_vertices;
+
+	const double quads_ns =
+		timeBake_(world, *tileset, num_passes, bakeQuads_, quad_vertices);
+	const double sprites_ns =
+		timeBake_(world, *tileset, num_passes, bakeSprites_, sprite_vertices);
+
+	const nemo::type::RowColumnIndex size = world.size();
+
+	// Vertex counts are printed so neither bake can be optimized away.
+	std::cout
+		<< size._r << "x" << size._c << " tiles, " << num_passes
+		<< " passes\n"
+		<< "  writeQuads:    " << quads_ns << " ns/tile, "
+		<< quad_vertices.size() << " vertices\n"
+		<< "  getTileSprite: " << sprites_ns << " ns/tile, "
+		<< sprite_vertices.size() << " vertices\n";
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,180 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \copyright MIT License                                                   ///
+/// \author    Caylen Lee                                                    ///
+/// \date      2019                                                          ///
+////////////////////////////////////////////////////////////////////////////////
+#include "World/World.hpp"
+#include "World/TilemapRenderer.hpp"
+#include "World/Tileset.hpp"
+#include "World/Tile.hpp"
+#include "type/RowColumnIndex.hpp"
+#include "constants.hpp"
+
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <string>
+
+namespace
+{
+	/**
+	 * \brief
+	 * Draws every tile sprite of an area map with its own draw call, the way
+	 * tiles were drawn before \link nemo::TilemapRenderer.
+	 *
+	 * \param target     Render target to draw on.
+	 * \param world      Area map to draw.
+	 * \param tileset    Tileset the tile sprites come from.
+	 *
+	 * \return
+	 * Number of draw calls issued.
+	 */
+	std::size_t
+	drawPerSprite_(
+		sf::RenderTarget&    target,
+		const nemo::World&   world,
+		const nemo::Tileset& tileset
+	)
+	{
+		constexpr auto length =
+			static_cast< float >(nemo::constants::_tile_side_length);
+		const nemo::type::RowColumnIndex size = world.size();
+		std::size_t num_draws = 0;
+
+		for (unsigned r = 0; r < size._r; ++r) {
+			for (unsigned c = 0; c < size._c; ++c) {
+				const nemo::type::RowColumnIndex world_index = {
+					nemo::type::row_t(r), nemo::type::column_t(c)
+				};
+
+				const nemo::Tile& tile = world.getTile(world_index);
+
+				for (std::size_t i = 0; i < tile.numLayers(); ++i) {
+					sf::Sprite sprite = tileset.getTileSprite(
+						nemo::Tile::unpackIndex(tile.layers()[i])
+					);
+
+					sprite.setPosition(world_index.sfVector2< float >() * length);
+					target.draw(sprite);
+					++num_draws;
+				}
+			}
+		}
+
+		return num_draws;
+	}
+
+	/**
+	 * \brief
+	 * Draws frames back to back and times them.
+	 *
+	 * \param target        Render target to draw on.
+	 * \param num_frames    Number of frames to draw.
+	 * \param draw          Draws one frame's tiles.
+	 *
+	 * \return
+	 * Average time per frame, in milliseconds.
+	 */
+	double
+	timeFrames_(
+		sf::RenderTexture&             target,
+		const unsigned long            num_frames,
+		const std::function< void() >& draw
+	)
+	{
+		using clock = std::chrono::steady_clock;
+		const auto start = clock::now();
+
+		for (unsigned long i = 0; i < num_frames; ++i) {
+			target.clear();
+			draw();
+			target.display();
+		}
+
+		// Reading the frame back waits for the graphics card to finish drawing,
+		// so queued draw calls are counted too.
+		target.getTexture().copyToImage();
+
+		const std::chrono::duration< double, std::milli > elapsed =
+			clock::now() - start;
+
+		return elapsed.count() / num_frames;
+	}
+}
+
+/**
+ * \brief
+ * Compares the draw calls and frame time of drawing an area map through
+ * \link nemo::TilemapRenderer against drawing one sprite at a time.
+ *
+ * Usage:
+ * \code
+ * 	nemodrawbench <world> [<frames>]
+ * \endcode
+ *
+ * The whole area map is drawn into an off-screen render texture, so no window
+ * is opened. Frames default to 100.
+ */
+int
+main(int argc, char* argv[])
+{
+	unsigned long num_frames = 100;
+
+	try {
+		if (argc == 3) {
+			num_frames = std::stoul(argv[2]);
+		}
+	}
+	catch (const std::exception&) {
+		num_frames = 0;
+	}
+
+	if (argc < 2 || argc > 3 || num_frames == 0) {
+		std::cerr << "Usage: nemodrawbench <world> [<frames>]\n";
+		return EXIT_FAILURE;
+	}
+
+	const nemo::World world(argv[1]);
+	const nemo::Tileset* tileset = world.tileset();
+
+	if (!tileset) {
+		std::cerr << "Area map " << argv[1] << " has no tileset to draw\n";
+		return EXIT_FAILURE;
+	}
+
+	sf::RenderTexture target;
+
+	if (!target.create(1280, 720)) {
+		std::cerr << "Failed to create a render texture\n";
+		return EXIT_FAILURE;
+	}
+
+	nemo::TilemapRenderer renderer(world);
+	std::size_t sprite_draws = 0;
+
+	const double batched_ms = timeFrames_(target, num_frames, [&] {
+		renderer.draw(target);
+	});
+
+	const double sprite_ms = timeFrames_(target, num_frames, [&] {
+		sprite_draws = drawPerSprite_(target, world, *tileset);
+	});
+
+	const nemo::type::RowColumnIndex size = world.size();
+
+	std::cout
+		<< size._r << "x" << size._c << " tiles, " << num_frames
+		<< " frames\n"
+		<< "  batched:    " << renderer.drawCalls() << " draw calls, "
+		<< batched_ms << " ms/frame\n"
+		<< "  per sprite: " << sprite_draws << " draw calls, "
+		<< sprite_ms << " ms/frame\n";
+
+	return EXIT_SUCCESS;
+}
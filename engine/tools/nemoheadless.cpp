@@ -0,0 +1,105 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \copyright MIT License                                                   ///
+/// \author    Caylen Lee                                                    ///
+/// \date      2019                                                          ///
+////////////////////////////////////////////////////////////////////////////////
+#include "Game.hpp"
+#include "entity/EntityMake.hpp"
+#include "constants.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace
+{
+	/// Entities simulated unless told otherwise: the most the game is meant to
+	/// keep up with.
+	constexpr unsigned long default_entities_ = 50000;
+}
+
+/**
+ * \brief
+ * Runs the game's simulation without a window, to measure its throughput on
+ * machines with no display or GPU.
+ *
+ * Usage:
+ * \code
+ * 	nemoheadless <ticks> [<entities> [<seed>]]
+ * \endcode
+ *
+ * NPCs are added until the game has the given number of entities, 50000 by 
+ * default, laid out on a grid so they don't start on top of each other. The 
+ * given number of ticks is then run back to back, with nothing drawn, and the
+ * tick rate achieved is printed. NPCs collide with the game's area map, same 
+ * as when playing. Runs with the same seed play out the same. Nothing is 
+ * drawn, so the area map's tileset is never loaded and no graphics context is
+ * created.
+ *
+ * Fails if the ticks ran slower than \link nemo::constants::_tick_rate, i.e. 
+ * the game couldn't keep up with that many entities. Check a release build, 
+ * i.e. made with RELEASE=1.
+ */
+int
+main(int argc, char* argv[])
+{
+	unsigned long num_ticks = 0;
+	unsigned long num_entities = default_entities_;
+	unsigned long long seed = 0;
+
+	try {
+		if (argc >= 2 && argc <= 4) {
+			num_ticks = std::stoul(argv[1]);
+			num_entities = argc >= 3 ? std::stoul(argv[2]) : num_entities;
+			seed = argc == 4 ? std::stoull(argv[3]) : 0;
+		}
+	}
+	catch (const std::exception&) {
+		num_ticks = 0;
+	}
+
+	if (num_ticks == 0) {
+		std::cerr << "Usage: nemoheadless <ticks> [<entities> [<seed>]]\n";
+		return EXIT_FAILURE;
+	}
+
+	nemo::Game& game = nemo::Game::getInstance();
+	nemo::EntityRegistry& entities = game.entities();
+	entities.reserve(num_entities);
+	entities.seed(seed);
+
+	constexpr auto length = nemo::constants::_tile_side_length;
+	const auto columns = static_cast< unsigned long >(
+		std::ceil(std::sqrt(static_cast< double >(num_entities)))
+	);
+
+	for (unsigned long i = entities.size(); i < num_entities; ++i) {
+		// Two tiles apart, so every NPC has room to wander.
+		nemo::EntityMake::teenageBoy(entities).teleport({
+			nemo::type::x_t(2 * length * (i % columns)),
+			nemo::type::y_t(2 * length * (i / columns))
+		});
+	}
+
+	using clock = std::chrono::steady_clock;
+	const auto start = clock::now();
+
+	for (unsigned long i = 0; i < num_ticks; ++i) {
+		game.tick();
+	}
+
+	const std::chrono::duration< double > elapsed = clock::now() - start;
+	const double ticks_per_second = num_ticks / elapsed.count();
+	const bool is_keeping_up = ticks_per_second >= nemo::constants::_tick_rate;
+
+	std::cout
+		<< num_ticks << " ticks of " << entities.size() << " entities in "
+		<< elapsed.count() << " s: " << ticks_per_second << " ticks/sec, "
+		<< elapsed.count() * 1000 / num_ticks << " ms/tick\n"
+		<< "  target " << nemo::constants::_tick_rate << " ticks/sec: "
+		<< (is_keeping_up ? "met" : "missed") << "\n";
+
+	return is_keeping_up ? EXIT_SUCCESS : EXIT_FAILURE;
+}
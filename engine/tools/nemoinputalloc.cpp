@@ -0,0 +1,223 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \copyright MIT License                                                   ///
+/// \author    Caylen Lee                                                    ///
+/// \date      2019                                                          ///
+////////////////////////////////////////////////////////////////////////////////
+#include "Controller.hpp"
+#include "InputPump.hpp"
+
+#include <SFML/Window/Event.hpp>
+#include <SFML/Window/Keyboard.hpp>
+
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace
+{
+	/// Allocations made by this thread so far. Other threads, like the async
+	/// logger's, are left out.
+	thread_local std::size_t num_allocations_ = 0;
+
+	/// Most keys pressed in a frame; more than the controller tracks at once,
+	/// so the oldest presses get overwritten.
+	constexpr std::size_t keys_per_frame_ =
+		nemo::Controller::_max_pressed_keys + 4;
+
+	/**
+	 * \brief
+	 * Allocates memory and counts the allocation.
+	 *
+	 * \param size
+	 * Number of bytes.
+	 *
+	 * \return
+	 * Allocated memory.
+	 */
+	void*
+	allocate_(const std::size_t size)
+	{
+		++num_allocations_;
+
+		if (void* p = std::malloc(size ? size : 1)) {
+			return p;
+		}
+
+		throw std::bad_alloc();
+	}
+
+	/**
+	 * \brief
+	 * Makes a key press or release event.
+	 *
+	 * \param type    sf::Event::KeyPressed or sf::Event::KeyReleased.
+	 * \param key     Key pressed or released.
+	 *
+	 * \return
+	 * Event.
+	 */
+	nemo::InputEvent
+	keyEvent_(const sf::Event::EventType type, const sf::Keyboard::Key key)
+	{
+		nemo::InputEvent e = {};
+		e._event.type = type;
+		e._event.key.code = key;
+		e._timestamp = nemo::InputEvent::clock_t::now();
+		return e;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void*
+operator new(std::size_t size)
+{
+	return allocate_(size);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void*
+operator new[](std::size_t size)
+{
+	return allocate_(size);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+operator delete(void* p) noexcept
+{
+	std::free(p);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+operator delete[](void* p) noexcept
+{
+	std::free(p);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+operator delete(void* p, std::size_t) noexcept
+{
+	std::free(p);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void
+operator delete[](void* p, std::size_t) noexcept
+{
+	std::free(p);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * \brief
+ * Checks that the controller's per-frame input handling never allocates.
+ *
+ * Usage:
+ * \code
+ * 	nemoinputalloc [<frames>]
+ * \endcode
+ *
+ * Every frame presses a batch of keys through the window events path, queries
+ * the controller the way the game does, saves and restores the pressed keys
+ * the way input replays do, and releases the keys again. Global operator new
+ * is replaced with one that counts allocations, and the program fails if any
+ * were made during the frames. Frames default to 10000.
+ *
+ * Debug builds log every key press and release, so check a release build,
+ * i.e. made with RELEASE=1, where those messages compile to nothing.
+ */
+int
+main(int argc, char* argv[])
+{
+	unsigned long num_frames = 10000;
+
+	try {
+		if (argc == 2) {
+			num_frames = std::stoul(argv[1]);
+		}
+	}
+	catch (const std::exception&) {
+		num_frames = 0;
+	}
+
+	if (argc > 2 || num_frames == 0) {
+		std::cerr << "Usage: nemoinputalloc [<frames>]\n";
+		return EXIT_FAILURE;
+	}
+
+	// Everything that is allowed to allocate happens before the frames.
+	const nemo::Controller controller;
+	std::vector< nemo::InputEvent > events;
+	events.reserve(keys_per_frame_ * 2);
+	nemo::Controller::pressed_keys_t keys = {};
+	std::size_t num_found = 0;
+
+	const std::size_t start = num_allocations_;
+
+	for (unsigned long i = 0; i < num_frames; ++i) {
+		// Press a different run of keys each frame, more than can be tracked.
+		events.clear();
+
+		for (std::size_t k = 0; k < keys_per_frame_; ++k) {
+			const auto key = static_cast< sf::Keyboard::Key >(
+				(i + k * 3) % sf::Keyboard::KeyCount
+			);
+
+			events.push_back(keyEvent_(sf::Event::KeyPressed, key));
+		}
+
+		nemo::Controller::registerKeyEvents(events);
+
+		num_found += controller.pressedDirection().has_value();
+		num_found += controller.pressedSelection().has_value();
+		num_found += controller.pressedButton().has_value();
+		num_found += controller.pressedButton({
+			nemo::Button::Left, nemo::Button::Select
+		}).has_value();
+
+		const std::size_t count = nemo::Controller::pressedKeys(keys);
+		nemo::Controller::setPressedKeys(keys, count);
+
+		// Release every other key through events, and the rest directly.
+		events.clear();
+
+		for (std::size_t k = 0; k < count; ++k) {
+			if (k % 2 == 0) {
+				events.push_back(keyEvent_(sf::Event::KeyReleased, keys[k]));
+			}
+			else {
+				nemo::Controller::registerKeyRelease(keys[k]);
+			}
+		}
+
+		nemo::Controller::registerKeyEvents(events);
+	}
+
+	const std::size_t num_allocations = num_allocations_ - start;
+
+	std::cout
+		<< num_frames << " frames, " << num_found << " buttons found, "
+		<< num_allocations << " allocations\n";
+
+	return num_allocations == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,40 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \copyright MIT License                                                   ///
+/// \author    Caylen Lee                                                    ///
+/// \date      2019                                                          ///
+////////////////////////////////////////////////////////////////////////////////
+#include "World/World.hpp"
+
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+
+/**
+ * \brief
+ * Offline compiler from json area maps to the binary .nemomap format.
+ *
+ * Usage:
+ * \code
+ * 	nemomapc <world.json> [<world.nemomap>]
+ * \endcode
+ *
+ * If the output path is omitted, the compiled area map is written next to the
+ * json file with its extension replaced by .nemomap.
+ */
+int
+main(int argc, char* argv[])
+{
+	if (argc < 2 || argc > 3) {
+		std::cerr << "Usage: nemomapc <world.json> [<world.nemomap>]\n";
+		return EXIT_FAILURE;
+	}
+
+	const std::filesystem::path json_file = argv[1];
+	const std::filesystem::path compiled_file = argc == 3
+		? std::filesystem::path(argv[2])
+		: std::filesystem::path(json_file).replace_extension(".nemomap");
+
+	return nemo::World::compile(json_file, compiled_file)
+		? EXIT_SUCCESS
+		: EXIT_FAILURE;
+}
@@ -0,0 +1,420 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \copyright MIT License                                                   ///
+/// \author    Caylen Lee                                                    ///
+/// \date      2019                                                          ///
+////////////////////////////////////////////////////////////////////////////////
+#include "World/World.hpp"
+#include "World/Tile.hpp"
+#include "type/RowColumnIndex.hpp"
+#include "type/Vector2.hpp"
+#include "constants.hpp"
+
+#include <type_safe/strong_typedef.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+	/**
+	 * \brief
+	 * Tile the way it was stored before the walkability bitmap: its own
+	 * walkable flag next to a heap-allocated list of tileset indices.
+	 */
+	struct OldTile_
+	{
+		bool                                      _is_walkable;
+		std::vector< nemo::type::RowColumnIndex > _tile_indices;
+	};
+
+	/**
+	 * \brief
+	 * Area map's tiles in the old per-tile layout, in row-major order.
+	 */
+	struct OldWorld_
+	{
+		std::vector< OldTile_ > _tiles;
+		long long               _num_rows;
+		long long               _num_columns;
+	};
+
+	/**
+	 * \brief
+	 * Random rectangle, ray or box move to query.
+	 */
+	struct Query_
+	{
+		long long _r, _c;   /// Top-left or starting tile.
+		long long _h, _w;   /// Rows and columns, or ending tile.
+		long long _dx, _dy; /// Box move, in pixels.
+	};
+
+	/// Runs one query against the area map; returns a result to sum up.
+	using query_t = std::function< long long(const Query_&) >;
+
+	/**
+	 * \brief          Divides, rounding towards negative infinity.
+	 * \param a        Dividend.
+	 * \param b        Divisor, greater than 0.
+	 * \return         Quotient.
+	 */
+	constexpr long long
+	floor_div_(const long long a, const long long b)
+	noexcept
+	{
+		return a >= 0 ? a / b : -((-a + b - 1) / b);
+	}
+
+	/**
+	 * \brief
+	 * Copies an area map's tiles into the old per-tile layout.
+	 *
+	 * \param world    Area map to copy.
+	 *
+	 * \return
+	 * Copy of the area map.
+	 */
+	OldWorld_
+	makeOldWorld_(const nemo::World& world)
+	{
+		const nemo::type::RowColumnIndex size = world.size();
+		OldWorld_ old = { {}, size._r, size._c };
+		old._tiles.reserve(std::size_t(size._r) * size._c);
+
+		for (unsigned r = 0; r < size._r; ++r) {
+			for (unsigned c = 0; c < size._c; ++c) {
+				const nemo::type::RowColumnIndex world_index = {
+					nemo::type::row_t(r), nemo::type::column_t(c)
+				};
+
+				old._tiles.push_back({
+					world.isWalkable(world_index),
+					std::vector< nemo::type::RowColumnIndex >(
+						world.getTile(world_index).numLayers()
+					)
+				});
+			}
+		}
+
+		return old;
+	}
+
+	/**
+	 * \brief
+	 * Tests every tile of an area of the old layout one at a time.
+	 *
+	 * \param old         Area map.
+	 * \param row         First row of the area.
+	 * \param column      First column of the area.
+	 * \param num_rows    Number of rows of the area.
+	 * \param num_cols    Number of columns of the area.
+	 *
+	 * \return
+	 * True if all tiles in the area are walkable, false if any isn't or if the
+	 * area reaches outside the area map.
+	 */
+	bool
+	isOldAreaWalkable_(
+		const OldWorld_& old,
+		const long long  row,
+		const long long  column,
+		const long long  num_rows,
+		const long long  num_cols
+	)
+	{
+		if (row < 0 || column < 0 || row + num_rows > old._num_rows ||
+			column + num_cols > old._num_columns)
+		{
+			return false;
+		}
+
+		for (long long r = row; r < row + num_rows; ++r) {
+			for (long long c = column; c < column + num_cols; ++c) {
+				if (!old._tiles[r * old._num_columns + c]._is_walkable) {
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	/**
+	 * \brief
+	 * Same as \link nemo::World::sweepBox, over the old layout.
+	 *
+	 * \param old      Area map.
+	 * \param query    Box to move; its size is one tile.
+	 *
+	 * \return
+	 * Sum of how far the box can move along each axis, in pixels.
+	 */
+	long long
+	sweepOldBox_(const OldWorld_& old, const Query_& query)
+	{
+		constexpr long long length = nemo::constants::_tile_side_length;
+		long long x = query._c * length;
+		long long y = query._r * length;
+		long long dx = query._dx;
+		long long dy = query._dy;
+
+		const auto sweep_axis = [] (
+			const long long edge,
+			long long&      delta,
+			const auto&     is_line_walkable
+		)
+		{
+			const long long step = delta > 0 ? 1 : -1;
+			const long long from = floor_div_(edge, length);
+			const long long to = floor_div_(edge + delta, length);
+
+			for (long long i = from + step; i != to + step; i += step) {
+				if (!is_line_walkable(i)) {
+					delta = delta > 0
+						? i * length - 1 - edge
+						: (i + 1) * length - edge;
+					return;
+				}
+			}
+		};
+
+		if (dx != 0) {
+			const long long row = floor_div_(y, length);
+			const long long num_rows =
+				floor_div_(y + length - 1, length) - row + 1;
+			const long long edge = dx > 0 ? x + length - 1 : x;
+
+			sweep_axis(edge, dx, [&] (const long long c) {
+				return isOldAreaWalkable_(old, row, c, num_rows, 1);
+			});
+
+			x += dx;
+		}
+
+		if (dy != 0) {
+			const long long column = floor_div_(x, length);
+			const long long num_cols =
+				floor_div_(x + length - 1, length) - column + 1;
+			const long long edge = dy > 0 ? y + length - 1 : y;
+
+			sweep_axis(edge, dy, [&] (const long long r) {
+				return isOldAreaWalkable_(old, r, column, 1, num_cols);
+			});
+		}
+
+		return dx + dy;
+	}
+
+	/**
+	 * \brief
+	 * Same as \link nemo::World::countBlocked, over the old layout.
+	 *
+	 * \param old      Area map.
+	 * \param query    Tiles the line starts and ends at.
+	 *
+	 * \return
+	 * Number of non-walkable tiles on the line.
+	 */
+	long long
+	countOldBlocked_(const OldWorld_& old, const Query_& query)
+	{
+		long long r = query._r;
+		long long c = query._c;
+		const long long dr = std::abs(query._h - r);
+		const long long dc = std::abs(query._w - c);
+		const long long step_r = r < query._h ? 1 : -1;
+		const long long step_c = c < query._w ? 1 : -1;
+		long long err = dc - dr;
+		long long count = 0;
+
+		while (true) {
+			count += !isOldAreaWalkable_(old, r, c, 1, 1);
+
+			if (r == query._h && c == query._w) {
+				break;
+			}
+
+			const long long err2 = 2 * err;
+
+			if (err2 > -dr) {
+				err -= dr;
+				c += step_c;
+			}
+
+			if (err2 < dc) {
+				err += dc;
+				r += step_r;
+			}
+		}
+
+		return count;
+	}
+
+	/**
+	 * \brief
+	 * Runs queries back to back and times them.
+	 *
+	 * \param queries    Queries to run.
+	 * \param query      Runs one query.
+	 * \param sum        Sum of the query results.
+	 *
+	 * \return
+	 * Average time per query, in nanoseconds.
+	 */
+	double
+	timeQueries_(
+		const std::vector< Query_ >& queries,
+		const query_t&               query,
+		long long&                   sum
+	)
+	{
+		using clock = std::chrono::steady_clock;
+		const auto start = clock::now();
+		sum = 0;
+
+		for (const Query_& q : queries) {
+			sum += query(q);
+		}
+
+		const std::chrono::duration< double, std::nano > elapsed =
+			clock::now() - start;
+
+		return elapsed.count() / queries.size();
+	}
+}
+
+/**
+ * \brief
+ * Compares the area map's walkability queries over its packed bitmap against
+ * the same queries over the old layout, where each tile kept its own flag.
+ *
+ * Usage:
+ * \code
+ * 	nemowalkbench <world> [<queries>]
+ * \endcode
+ *
+ * Times the given number of random queries of each kind, 100000 by default:
+ * areas of up to 8x64 tiles, rays of which half run along a row, and one-tile
+ * boxes moved up to 8 tiles each way. The average time per query is printed.
+ * Fails if the two layouts give different answers.
+ */
+int
+main(int argc, char* argv[])
+{
+	unsigned long num_queries = 100000;
+
+	try {
+		if (argc == 3) {
+			num_queries = std::stoul(argv[2]);
+		}
+	}
+	catch (const std::exception&) {
+		num_queries = 0;
+	}
+
+	if (argc < 2 || argc > 3 || num_queries == 0) {
+		std::cerr << "Usage: nemowalkbench <world> [<queries>]\n";
+		return EXIT_FAILURE;
+	}
+
+	const nemo::World world(argv[1]);
+	const OldWorld_ old = makeOldWorld_(world);
+	const nemo::type::RowColumnIndex size = world.size();
+
+	if (size._r == 0 || size._c == 0) {
+		std::cerr << "Area map " << argv[1] << " has no tiles\n";
+		return EXIT_FAILURE;
+	}
+
+	// Same queries every run.
+	std::mt19937 rng(0);
+	const auto below = [&rng] (const long long n) {
+		return std::uniform_int_distribution< long long >(0, n - 1)(rng);
+	};
+
+	constexpr long long length = nemo::constants::_tile_side_length;
+	std::vector< Query_ > queries(num_queries);
+
+	for (unsigned long i = 0; i < num_queries; ++i) {
+		Query_& q = queries[i];
+		q._r = below(size._r);
+		q._c = below(size._c);
+		q._h = i % 2 == 0 ? q._r : below(size._r);
+		q._w = below(size._c);
+		q._dx = below(16 * length + 1) - 8 * length;
+		q._dy = below(16 * length + 1) - 8 * length;
+	}
+
+	const auto index = [] (const long long r, const long long c) {
+		return nemo::type::RowColumnIndex(
+			nemo::type::row_t(static_cast< unsigned >(r)),
+			nemo::type::column_t(static_cast< unsigned >(c))
+		);
+	};
+
+	long long sums[6] = {};
+
+	const double area_ns = timeQueries_(queries, [&] (const Query_& q) {
+		return static_cast< long long >(world.isWalkable(
+			index(q._r, q._c), index(1 + q._h % 8, 1 + q._w % 64)
+		));
+	}, sums[0]);
+
+	const double old_area_ns = timeQueries_(queries, [&] (const Query_& q) {
+		return static_cast< long long >(isOldAreaWalkable_(
+			old, q._r, q._c, 1 + q._h % 8, 1 + q._w % 64
+		));
+	}, sums[1]);
+
+	const double ray_ns = timeQueries_(queries, [&] (const Query_& q) {
+		return static_cast< long long >(world.countBlocked(
+			index(q._r, q._c), index(q._h, q._w)
+		));
+	}, sums[2]);
+
+	const double old_ray_ns = timeQueries_(queries, [&] (const Query_& q) {
+		return countOldBlocked_(old, q);
+	}, sums[3]);
+
+	const double sweep_ns = timeQueries_(queries, [&] (const Query_& q) {
+		const nemo::World::SweepResult result = world.sweepBox(
+			{ nemo::type::x_t(q._c * length), nemo::type::y_t(q._r * length) },
+			{ nemo::type::x_t(length), nemo::type::y_t(length) },
+			{ nemo::type::x_t(q._dx), nemo::type::y_t(q._dy) }
+		);
+
+		return static_cast< long long >(
+			type_safe::get(result._displacement._x) +
+			type_safe::get(result._displacement._y)
+		);
+	}, sums[4]);
+
+	const double old_sweep_ns = timeQueries_(queries, [&] (const Query_& q) {
+		return sweepOldBox_(old, q);
+	}, sums[5]);
+
+	// Sums are printed so no query can be optimized away.
+	std::cout
+		<< size._r << "x" << size._c << " tiles, " << num_queries
+		<< " queries of each kind\n"
+		<< "  isWalkable:   " << area_ns << " ns, per tile " << old_area_ns
+		<< " ns (" << sums[0] << " walkable)\n"
+		<< "  countBlocked: " << ray_ns << " ns, per tile " << old_ray_ns
+		<< " ns (" << sums[2] << " blocked)\n"
+		<< "  sweepBox:     " << sweep_ns << " ns, per tile " << old_sweep_ns
+		<< " ns (" << sums[4] << " px moved)\n";
+
+	if (sums[0] != sums[1] || sums[2] != sums[3] || sums[4] != sums[5]) {
+		std::cerr << "Bitmap and per-tile layouts disagree\n";
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}